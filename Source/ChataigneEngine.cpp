@@ -69,8 +69,10 @@ ChataigneEngine::~ChataigneEngine()
 	ModuleRouterManager::deleteInstance();
 
 	ChataigneSequenceManager::deleteInstance();
+	AudioEnvelopeManager::deleteInstance();
 	StateManager::deleteInstance();
 	ModuleManager::deleteInstance();
+	AudioStreamManager::deleteInstance();
 
 	MIDIManager::deleteInstance();
 	DMXManager::deleteInstance();
@@ -83,6 +85,10 @@ ChataigneEngine::~ChataigneEngine()
 	ChataigneAssetManager::deleteInstance();
 
 	CVGroupManager::deleteInstance();
+	ConditionSourceIndex::deleteInstance();
+	EventScheduler::deleteInstance();
+	ContinuousProcessScheduler::deleteInstance();
+	LayerBakePool::deleteInstance();
 
 	Guider::deleteInstance();
 }
@@ -0,0 +1,364 @@
+/*
+  ==============================================================================
+
+    AudioEnvelopeManager.cpp
+    Created: 18 Oct 2026 5:02:17pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+AudioEnvelope::AudioEnvelope(const File& file) :
+	file(file),
+	sampleRate(0),
+	lengthInSamples(0),
+	isReady(false),
+	hasFailed(false),
+	segmentsLeft(0)
+{
+}
+
+AudioEnvelope::~AudioEnvelope()
+{
+}
+
+float AudioEnvelope::getValue(Type type, double time, double windowLength) const
+{
+	if (!isReady || levels.isEmpty()) return 0;
+
+	//pick the coarsest level that still has at least one frame in the window
+	int64 windowSamples = jmax<int64>(1, (int64)(windowLength * sampleRate));
+	const Level* level = levels.getFirst();
+	for (auto& l : levels)
+	{
+		if (l->hopSize > windowSamples) break;
+		level = l;
+	}
+
+	int start = jlimit(0, level->numFrames - 1, (int)(time * sampleRate / level->hopSize));
+	int end = jlimit(start + 1, level->numFrames, (int)((time * sampleRate + windowSamples) / level->hopSize) + 1);
+
+	switch (type)
+	{
+	case RMS:
+	{
+		double sum = 0;
+		for (int i = start; i < end; ++i) sum += level->rms[i] * level->rms[i];
+		return (float)std::sqrt(sum / (end - start));
+	}
+
+	case PEAK:
+	{
+		float result = 0;
+		for (int i = start; i < end; ++i) result = jmax(result, level->peak[i]);
+		return result;
+	}
+
+	case ONSET:
+	{
+		float result = 0;
+		for (int i = start; i < end; ++i) result = jmax(result, level->onset[i]);
+		return result;
+	}
+	}
+
+	return 0;
+}
+
+File AudioEnvelope::getCacheFile() const
+{
+	return file.getSiblingFile(file.getFileName() + ".cenv");
+}
+
+bool AudioEnvelope::loadCache()
+{
+	File f = getCacheFile();
+	if (!f.existsAsFile()) return false;
+
+	FileInputStream stream(f);
+	if (stream.failedToOpen()) return false;
+
+	if ((uint32)stream.readInt() != AUDIO_ENVELOPE_MAGIC || stream.readInt() != AUDIO_ENVELOPE_VERSION) return false;
+
+	//the cache is only valid for the exact file it was computed from
+	if (stream.readInt64() != file.getSize() || stream.readInt64() != file.getLastModificationTime().toMilliseconds()) return false;
+
+	double sr = stream.readDouble();
+	int64 length = stream.readInt64();
+	int hopSize = stream.readInt();
+	int numFrames = stream.readInt();
+
+	if (sr <= 0 || hopSize != AUDIO_ENVELOPE_HOP || numFrames != (int)((length + hopSize - 1) / hopSize)) return false;
+	if (stream.getNumBytesRemaining() < (int64)numFrames * 3 * (int64)sizeof(float)) return false;
+
+	allocate(sr, length);
+	Level* l = levels.getFirst();
+	stream.read(l->rms.get(), numFrames * (int)sizeof(float));
+	stream.read(l->peak.get(), numFrames * (int)sizeof(float));
+	stream.read(l->onset.get(), numFrames * (int)sizeof(float));
+
+	buildLevels();
+	isReady = true;
+	return true;
+}
+
+bool AudioEnvelope::saveCache() const
+{
+	if (levels.isEmpty()) return false;
+
+	File f = getCacheFile();
+	f.deleteFile();
+	std::unique_ptr<FileOutputStream> stream(f.createOutputStream());
+	if (stream == nullptr || stream->failedToOpen()) return false; //read-only folder, the envelope will just be computed again next time
+
+	const Level* l = levels.getFirst();
+	stream->writeInt((int)AUDIO_ENVELOPE_MAGIC);
+	stream->writeInt(AUDIO_ENVELOPE_VERSION);
+	stream->writeInt64(file.getSize());
+	stream->writeInt64(file.getLastModificationTime().toMilliseconds());
+	stream->writeDouble(sampleRate);
+	stream->writeInt64(lengthInSamples);
+	stream->writeInt(l->hopSize);
+	stream->writeInt(l->numFrames);
+	stream->write(l->rms.get(), l->numFrames * sizeof(float));
+	stream->write(l->peak.get(), l->numFrames * sizeof(float));
+	stream->write(l->onset.get(), l->numFrames * sizeof(float));
+	stream->flush();
+
+	return !stream->getStatus().failed();
+}
+
+void AudioEnvelope::allocate(double sr, int64 length)
+{
+	sampleRate = sr;
+	lengthInSamples = length;
+
+	levels.clear();
+	Level* l = levels.add(new Level());
+	l->hopSize = AUDIO_ENVELOPE_HOP;
+	l->numFrames = jmax(1, (int)((length + AUDIO_ENVELOPE_HOP - 1) / AUDIO_ENVELOPE_HOP));
+	l->rms.calloc(l->numFrames);
+	l->peak.calloc(l->numFrames);
+	l->onset.calloc(l->numFrames);
+}
+
+void AudioEnvelope::analyzeSegment(AudioFormatReader* reader, int startFrame, int endFrame)
+{
+	//Streams the segment in blocks so memory stays the same whatever the file length
+	const int hopsPerBlock = 128;
+	const int numChannels = jmax(1, (int)reader->numChannels);
+	AudioBuffer<float> buffer(numChannels, AUDIO_ENVELOPE_HOP * hopsPerBlock);
+
+	Level* l = levels.getFirst();
+
+	for (int frame = startFrame; frame < endFrame; frame += hopsPerBlock)
+	{
+		int numHops = jmin(hopsPerBlock, endFrame - frame);
+		int64 startSample = (int64)frame * AUDIO_ENVELOPE_HOP;
+		int numSamples = (int)jmin<int64>((int64)numHops * AUDIO_ENVELOPE_HOP, lengthInSamples - startSample);
+		if (numSamples <= 0) break;
+
+		reader->read(&buffer, 0, numSamples, startSample, true, true);
+
+		for (int h = 0; h < numHops; ++h)
+		{
+			int hopStart = h * AUDIO_ENVELOPE_HOP;
+			int hopLength = jmin(AUDIO_ENVELOPE_HOP, numSamples - hopStart);
+			if (hopLength <= 0) break;
+
+			double sumSquares = 0;
+			float peak = 0;
+			for (int c = 0; c < numChannels; ++c)
+			{
+				const float* data = buffer.getReadPointer(c, hopStart);
+				for (int i = 0; i < hopLength; ++i)
+				{
+					sumSquares += data[i] * data[i];
+					peak = jmax(peak, std::abs(data[i]));
+				}
+			}
+
+			l->rms[frame + h] = (float)(sumSquares / ((double)hopLength * numChannels)); //mean square, sqrt is done in finishAnalysis
+			l->peak[frame + h] = peak;
+		}
+	}
+}
+
+void AudioEnvelope::finishAnalysis()
+{
+	Level* l = levels.getFirst();
+
+	//Onset strength is the rectified rise of the log energy between two hops
+	float prevDb = -100;
+	for (int i = 0; i < l->numFrames; ++i)
+	{
+		float db = 10 * std::log10(jmax(l->rms[i], 1e-10f));
+		l->onset[i] = jlimit(0.f, 1.f, (db - prevDb) / 24.f);
+		prevDb = db;
+		l->rms[i] = std::sqrt(l->rms[i]);
+	}
+
+	buildLevels();
+	saveCache();
+	isReady = true;
+}
+
+void AudioEnvelope::buildLevels()
+{
+	while (levels.size() > 1) levels.removeLast();
+
+	while (levels.getLast()->numFrames > AUDIO_ENVELOPE_LEVEL_FACTOR)
+	{
+		const Level* src = levels.getLast();
+		Level* l = levels.add(new Level());
+		l->hopSize = src->hopSize * AUDIO_ENVELOPE_LEVEL_FACTOR;
+		l->numFrames = (src->numFrames + AUDIO_ENVELOPE_LEVEL_FACTOR - 1) / AUDIO_ENVELOPE_LEVEL_FACTOR;
+		l->rms.calloc(l->numFrames);
+		l->peak.calloc(l->numFrames);
+		l->onset.calloc(l->numFrames);
+
+		for (int i = 0; i < l->numFrames; ++i)
+		{
+			int start = i * AUDIO_ENVELOPE_LEVEL_FACTOR;
+			int end = jmin(start + AUDIO_ENVELOPE_LEVEL_FACTOR, src->numFrames);
+			double sum = 0;
+			for (int j = start; j < end; ++j)
+			{
+				sum += src->rms[j] * src->rms[j];
+				l->peak[i] = jmax(l->peak[i], src->peak[j]);
+				l->onset[i] = jmax(l->onset[i], src->onset[j]);
+			}
+			l->rms[i] = (float)std::sqrt(sum / (end - start));
+		}
+	}
+}
+
+
+
+juce_ImplementSingleton(AudioEnvelopeManager)
+
+AudioEnvelopeManager::AudioEnvelopeManager() :
+	pool(jmax(1, SystemStats::getNumCpus() - 1))
+{
+	formatManager.registerBasicFormats();
+}
+
+AudioEnvelopeManager::~AudioEnvelopeManager()
+{
+	cancelPendingUpdate();
+	pool.removeAllJobs(true, 5000);
+}
+
+AudioEnvelope::Ptr AudioEnvelopeManager::requestEnvelope(const File& file)
+{
+	if (file == File()) return nullptr;
+
+	AudioEnvelope::Ptr e = findEnvelope(file);
+	if (e != nullptr) return e;
+
+	e = new AudioEnvelope(file);
+	{
+		GenericScopedLock lock(envelopeLock);
+		envelopes.add(e);
+	}
+
+	pool.addJob([this, e]() { load(e); });
+	return e;
+}
+
+AudioEnvelope::Ptr AudioEnvelopeManager::findEnvelope(const File& file)
+{
+	GenericScopedLock lock(envelopeLock);
+	for (auto& e : envelopes) if (e->file == file) return e;
+	return nullptr;
+}
+
+void AudioEnvelopeManager::purgeUnusedEnvelopes()
+{
+	GenericScopedLock lock(envelopeLock);
+	for (int i = envelopes.size() - 1; i >= 0; --i)
+	{
+		//only held by this manager, pending jobs hold their envelope too
+		if (envelopes.getObjectPointerUnchecked(i)->getReferenceCount() == 1) envelopes.remove(i);
+	}
+}
+
+void AudioEnvelopeManager::load(AudioEnvelope::Ptr envelope)
+{
+	if (!envelope->file.existsAsFile())
+	{
+		envelope->hasFailed = true;
+		envelopeFinished(envelope.get());
+		return;
+	}
+
+	if (envelope->loadCache()) envelopeFinished(envelope.get());
+	else analyze(envelope);
+}
+
+void AudioEnvelopeManager::analyze(AudioEnvelope::Ptr envelope)
+{
+	std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(envelope->file));
+	if (reader == nullptr || reader->lengthInSamples <= 0)
+	{
+		LOGWARNING("Could not read audio file " << envelope->file.getFileName() << " for analysis");
+		envelope->hasFailed = true;
+		envelopeFinished(envelope.get());
+		return;
+	}
+
+	envelope->allocate(reader->sampleRate, reader->lengthInSamples);
+
+	//Long files are split in segments analyzed in parallel, each job streams its own part of the file
+	int numFrames = envelope->levels.getFirst()->numFrames;
+	int framesPerSegment = jmax(1, (int)(30 * reader->sampleRate / AUDIO_ENVELOPE_HOP));
+	int numSegments = jlimit(1, jmax(1, pool.getNumThreads()), (numFrames + framesPerSegment - 1) / framesPerSegment);
+	framesPerSegment = (numFrames + numSegments - 1) / numSegments;
+
+	envelope->segmentsLeft = numSegments;
+
+	for (int i = 0; i < numSegments; ++i)
+	{
+		int startFrame = i * framesPerSegment;
+		int endFrame = jmin(numFrames, startFrame + framesPerSegment);
+
+		pool.addJob([this, envelope, startFrame, endFrame]()
+			{
+				std::unique_ptr<AudioFormatReader> segmentReader(formatManager.createReaderFor(envelope->file));
+				if (segmentReader != nullptr) envelope->analyzeSegment(segmentReader.get(), startFrame, endFrame);
+				else envelope->hasFailed = true;
+
+				if (--envelope->segmentsLeft == 0)
+				{
+					if (!envelope->hasFailed) envelope->finishAnalysis();
+					envelopeFinished(envelope.get());
+				}
+			});
+	}
+}
+
+void AudioEnvelopeManager::envelopeFinished(AudioEnvelope* envelope)
+{
+	{
+		GenericScopedLock lock(envelopeLock);
+		finishedEnvelopes.add(envelope);
+	}
+
+	triggerAsyncUpdate();
+}
+
+void AudioEnvelopeManager::handleAsyncUpdate()
+{
+	ReferenceCountedArray<AudioEnvelope> finished;
+	{
+		GenericScopedLock lock(envelopeLock);
+		finished.swapWith(finishedEnvelopes);
+		for (int i = finished.size() - 1; i >= 0; --i) if (!envelopes.contains(finished[i])) finished.remove(i); //purged meanwhile
+	}
+
+	for (auto& e : finished)
+	{
+		if (e->hasFailed) LOGWARNING("Analysis of " << e->file.getFileName() << " failed");
+		envelopeListeners.call(&EnvelopeListener::envelopeReady, e);
+	}
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    AudioEnvelopeManager.h
+    Created: 18 Oct 2026 5:02:17pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Envelope cache file layout (little endian), saved next to the audio file as <file>.cenv :
+
+	Header    : magic "CENV", version, source file size (int64), source modification time (int64),
+				sampleRate (double), lengthInSamples (int64), hopSize, numFrames
+	Data      : numFrames floats for each of rms, peak and onset, at hopSize resolution.
+				Coarser resolutions are rebuilt when loading.
+*/
+
+#define AUDIO_ENVELOPE_MAGIC ByteOrder::littleEndianInt("CENV")
+#define AUDIO_ENVELOPE_VERSION 1
+#define AUDIO_ENVELOPE_HOP 512
+#define AUDIO_ENVELOPE_LEVEL_FACTOR 4
+
+class AudioEnvelope :
+	public ReferenceCountedObject
+{
+public:
+	AudioEnvelope(const File& file);
+	~AudioEnvelope();
+
+	typedef ReferenceCountedObjectPtr<AudioEnvelope> Ptr;
+
+	enum Type { RMS, PEAK, ONSET };
+
+	struct Level
+	{
+		int hopSize;
+		int numFrames;
+		HeapBlock<float> rms; //mean square while analyzing, rms once finished
+		HeapBlock<float> peak;
+		HeapBlock<float> onset;
+	};
+
+	File file;
+	double sampleRate;
+	int64 lengthInSamples;
+	OwnedArray<Level> levels; //levels[0] has AUDIO_ENVELOPE_HOP resolution, each next one is AUDIO_ENVELOPE_LEVEL_FACTOR times coarser
+
+	std::atomic<bool> isReady;
+	std::atomic<bool> hasFailed;
+	std::atomic<int> segmentsLeft;
+
+	double getLength() const { return sampleRate > 0 ? lengthInSamples / sampleRate : 0; }
+	float getValue(Type type, double time, double windowLength) const;
+
+	File getCacheFile() const;
+	bool loadCache();
+	bool saveCache() const;
+
+	void allocate(double sampleRate, int64 lengthInSamples);
+	void analyzeSegment(AudioFormatReader* reader, int startFrame, int endFrame);
+	void finishAnalysis();
+
+private:
+	void buildLevels();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioEnvelope)
+};
+
+
+class AudioEnvelopeManager :
+	public AsyncUpdater
+{
+public:
+	juce_DeclareSingleton(AudioEnvelopeManager, true)
+	AudioEnvelopeManager();
+	~AudioEnvelopeManager();
+
+	AudioFormatManager formatManager;
+	ThreadPool pool;
+
+	CriticalSection envelopeLock;
+	ReferenceCountedArray<AudioEnvelope> envelopes;
+	ReferenceCountedArray<AudioEnvelope> finishedEnvelopes;
+
+	//Message thread : returns the envelope of the file, its cache is loaded or its analysis started in the background if it's new.
+	//Users keep the returned pointer as long as they need the envelope, envelopes nobody holds are dropped by purgeUnusedEnvelopes
+	AudioEnvelope::Ptr requestEnvelope(const File& file);
+
+	//Any thread : returns the envelope of the file if it was requested, without touching the file. Check isReady before reading it
+	AudioEnvelope::Ptr findEnvelope(const File& file);
+
+	void purgeUnusedEnvelopes();
+
+	void load(AudioEnvelope::Ptr envelope);
+	void analyze(AudioEnvelope::Ptr envelope);
+	void envelopeFinished(AudioEnvelope* envelope);
+
+	void handleAsyncUpdate() override;
+
+	class EnvelopeListener
+	{
+	public:
+		virtual ~EnvelopeListener() {}
+		virtual void envelopeReady(AudioEnvelope*) {}
+	};
+
+	ListenerList<EnvelopeListener> envelopeListeners;
+	void addEnvelopeListener(EnvelopeListener* newListener) { envelopeListeners.add(newListener); }
+	void removeEnvelopeListener(EnvelopeListener* listener) { envelopeListeners.remove(listener); }
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioEnvelopeManager)
+};
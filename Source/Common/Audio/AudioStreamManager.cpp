@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+    AudioStreamManager.cpp
+    Created: 18 Oct 2026 8:21:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+juce_ImplementSingleton(AudioStreamManager)
+
+AudioStreamManager::AudioStreamManager() :
+	readAheadThread("Audio Read-Ahead")
+{
+	formatManager.registerBasicFormats();
+
+	//files left unfinished by a previous session
+	for (auto& f : getPCMCacheDirectory().findChildFiles(File::findFiles, false, "*.tmp")) f.deleteFile();
+	cleanPCMCache();
+
+	readAheadThread.startThread(7);
+}
+
+AudioStreamManager::~AudioStreamManager()
+{
+	cancelPendingUpdate();
+	readAheadThread.stopThread(1000);
+	preloadJobs.clear();
+}
+
+AudioFormatReader* AudioStreamManager::createReaderFor(const File& file)
+{
+	if (!file.existsAsFile()) return nullptr;
+	return formatManager.createReaderFor(file);
+}
+
+bool AudioStreamManager::isPreloaded(AudioFormatReader* reader)
+{
+	return dynamic_cast<MemoryMappedAudioFormatReader*>(reader) != nullptr;
+}
+
+void AudioStreamManager::preload(const File& file, PreloadListener* listener)
+{
+	if (!file.existsAsFile()) return;
+
+	PreloadJob* job = new PreloadJob(this, file, listener);
+	{
+		GenericScopedLock lock(preloadLock);
+		preloadJobs.add(job);
+	}
+
+	readAheadThread.addTimeSliceClient(job);
+}
+
+void AudioStreamManager::cancelPreloads(PreloadListener* listener)
+{
+	OwnedArray<PreloadJob> jobsToCancel;
+	{
+		GenericScopedLock lock(preloadLock);
+		for (int i = preloadJobs.size() - 1; i >= 0; --i)
+		{
+			if (preloadJobs[i]->listener == listener) jobsToCancel.add(preloadJobs.removeAndReturn(i));
+		}
+	}
+
+	//waits for the slice being run, not under preloadLock as the jobs take it while running
+	for (auto& j : jobsToCancel) readAheadThread.removeTimeSliceClient(j);
+}
+
+void AudioStreamManager::handleAsyncUpdate()
+{
+	OwnedArray<PreloadJob> finishedJobs;
+	{
+		GenericScopedLock lock(preloadLock);
+		for (int i = preloadJobs.size() - 1; i >= 0; --i)
+		{
+			if (preloadJobs[i]->isFinished) finishedJobs.insert(0, preloadJobs.removeAndReturn(i));
+		}
+	}
+
+	for (auto& j : finishedJobs)
+	{
+		readAheadThread.removeTimeSliceClient(j);
+		j->listener->preloadFinished(j->file, j->reader.release());
+	}
+}
+
+AudioCue::Ptr AudioStreamManager::getCue(const File& file)
+{
+	if (!file.existsAsFile()) return nullptr;
+
+	GenericScopedLock lock(preloadLock);
+	for (auto& c : cues) if (c->file == file) return c;
+
+	std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(file));
+	if (reader == nullptr || reader->lengthInSamples <= 0) return nullptr;
+
+	if (reader->lengthInSamples > AUDIO_CUE_MAX_LENGTH * reader->sampleRate)
+	{
+		LOGWARNING(file.getFileName() << " is too long to be played as a cue, it will be streamed from disk");
+		return nullptr;
+	}
+
+	AudioCue::Ptr cue = new AudioCue(file);
+	cue->sampleRate = reader->sampleRate;
+	cue->buffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+	if (!reader->read(&cue->buffer, 0, (int)reader->lengthInSamples, 0, true, true)) return nullptr;
+
+	cues.add(cue);
+	return cue;
+}
+
+void AudioStreamManager::releaseUnusedCues()
+{
+	GenericScopedLock lock(preloadLock);
+	for (int i = cues.size() - 1; i >= 0; --i)
+	{
+		if (cues.getObjectPointerUnchecked(i)->getReferenceCount() == 1) cues.remove(i);
+	}
+}
+
+File AudioStreamManager::getPCMCacheDirectory()
+{
+	return File::getSpecialLocation(File::tempDirectory).getChildFile("Chataigne").getChildFile("AudioCache");
+}
+
+File AudioStreamManager::getPCMCacheFile(const File& file)
+{
+	//the name depends on the source path, size and date so an edited file is decoded again
+	String key = file.getFullPathName() + String(file.getSize()) + String(file.getLastModificationTime().toMilliseconds());
+	return getPCMCacheDirectory().getChildFile(file.getFileNameWithoutExtension() + "_" + String::toHexString(key.hashCode64()) + ".wav");
+}
+
+void AudioStreamManager::cleanPCMCache(const File& fileToKeep)
+{
+	Array<File> files = getPCMCacheDirectory().findChildFiles(File::findFiles, false, "*.wav");
+
+	//cache files are touched each time they are preloaded, remove the least recently used first
+	std::sort(files.begin(), files.end(), [](const File& f1, const File& f2) { return f1.getLastModificationTime() > f2.getLastModificationTime(); });
+
+	int64 totalSize = 0;
+	for (auto& f : files)
+	{
+		int64 size = f.getSize();
+		totalSize += size;
+		if (totalSize <= AUDIO_PCM_CACHE_MAX_SIZE || f == fileToKeep) continue;
+
+		//files still mapped by a player can't be deleted on some systems, they will be on a next cleaning
+		if (f.deleteFile()) totalSize -= size;
+	}
+}
+
+
+
+// PRELOAD JOB
+
+AudioStreamManager::PreloadJob::PreloadJob(AudioStreamManager* manager, const File& file, PreloadListener* listener) :
+	manager(manager),
+	file(file),
+	listener(listener),
+	decodePosition(0),
+	touchPosition(0),
+	samplesPerPage(1),
+	isFinished(false)
+{
+	if (!file.hasFileExtension("wav;aif;aiff")) cacheFile = manager->getPCMCacheFile(file);
+}
+
+AudioStreamManager::PreloadJob::~PreloadJob()
+{
+	//cancelled while decoding
+	if (writer != nullptr)
+	{
+		writer.reset();
+		tmpFile.deleteFile();
+	}
+}
+
+int AudioStreamManager::PreloadJob::useTimeSlice()
+{
+	if (isFinished) return -1;
+
+	if (reader == nullptr)
+	{
+		if (cacheFile != File() && !cacheFile.existsAsFile())
+		{
+			if (!decodeNextBlock()) finish(false);
+			return isFinished ? -1 : 0;
+		}
+
+		if (!mapFile())
+		{
+			finish(false);
+			return -1;
+		}
+
+		return 0;
+	}
+
+	//touch the pages a few at a time so the first play doesn't wait for the disk
+	for (int i = 0; i < AUDIO_PRELOAD_PAGES_PER_SLICE && touchPosition < reader->lengthInSamples; i++, touchPosition += samplesPerPage) reader->touchSample(touchPosition);
+
+	if (touchPosition < reader->lengthInSamples) return 0;
+
+	finish(true);
+	return -1;
+}
+
+bool AudioStreamManager::PreloadJob::decodeNextBlock()
+{
+	if (writer == nullptr)
+	{
+		{
+			//an other command preloading the same file is already decoding it, wait for it
+			GenericScopedLock lock(manager->preloadLock);
+			for (auto& j : manager->preloadJobs) if (j != this && j->cacheFile == cacheFile && j->writer != nullptr) return true;
+		}
+
+		sourceReader.reset(manager->formatManager.createReaderFor(file));
+		if (sourceReader == nullptr) return false;
+
+		cacheFile.getParentDirectory().createDirectory();
+		tmpFile = cacheFile.withFileExtension("tmp");
+		tmpFile.deleteFile();
+
+		std::unique_ptr<FileOutputStream> stream(tmpFile.createOutputStream());
+		if (stream == nullptr || stream->failedToOpen()) return false;
+
+		writer.reset(WavAudioFormat().createWriterFor(stream.get(), sourceReader->sampleRate, sourceReader->numChannels, 32, {}, 0));
+		if (writer == nullptr) return false;
+		stream.release(); //owned by the writer now
+
+		decodePosition = 0;
+		return true;
+	}
+
+	int numSamples = (int)jmin<int64>(AUDIO_PRELOAD_BLOCK_SIZE, sourceReader->lengthInSamples - decodePosition);
+	if (numSamples > 0)
+	{
+		if (!writer->writeFromAudioReader(*sourceReader, decodePosition, numSamples))
+		{
+			writer.reset();
+			tmpFile.deleteFile();
+			return false;
+		}
+
+		decodePosition += numSamples;
+		return true;
+	}
+
+	writer.reset();
+	sourceReader.reset();
+
+	//only complete files get the final name
+	tmpFile.moveFileTo(cacheFile);
+	NLOG("Audio", "Decoded " << file.getFileName() << " for preloading");
+
+	manager->cleanPCMCache(cacheFile);
+	return true;
+}
+
+bool AudioStreamManager::PreloadJob::mapFile()
+{
+	File mappedFile = cacheFile != File() ? cacheFile : file;
+	if (cacheFile != File()) cacheFile.setLastModificationTime(Time::getCurrentTime());
+
+	if (mappedFile.hasFileExtension("wav")) reader.reset(WavAudioFormat().createMemoryMappedReader(mappedFile));
+	else reader.reset(AiffAudioFormat().createMemoryMappedReader(mappedFile));
+
+	if (reader == nullptr || !reader->mapEntireFile()) return false;
+
+	samplesPerPage = jmax<int64>(1, 4096 / jmax<int64>(1, reader->getNumBytesUsed() / jmax<int64>(1, reader->lengthInSamples)));
+	touchPosition = 0;
+	return true;
+}
+
+void AudioStreamManager::PreloadJob::finish(bool success)
+{
+	if (!success)
+	{
+		reader.reset();
+		LOGWARNING("Could not preload " << file.getFileName() << ", it will be streamed from disk");
+	}
+
+	isFinished = true;
+	manager->triggerAsyncUpdate();
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    AudioStreamManager.h
+    Created: 18 Oct 2026 8:21:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Shared resources for playing audio files from disk :
+	- one background thread that fills the read-ahead buffers of all the players, so decoding never happens in the audio callback
+	- preloading in the background, wav and aiff files are memory mapped directly, other formats are decoded once to a PCM cache file that is then mapped
+	- cues, short files fully decoded in memory and shared by everything that plays them
+*/
+
+#define AUDIO_CUE_MAX_LENGTH 300 //seconds
+#define AUDIO_PCM_CACHE_MAX_SIZE ((int64)4 << 30) //bytes, decoded files are 32 bit float
+#define AUDIO_PRELOAD_BLOCK_SIZE 65536 //samples decoded per time slice
+#define AUDIO_PRELOAD_PAGES_PER_SLICE 256
+
+class AudioCue :
+	public ReferenceCountedObject
+{
+public:
+	AudioCue(const File& file) : file(file), sampleRate(44100) {}
+	~AudioCue() {}
+
+	typedef ReferenceCountedObjectPtr<AudioCue> Ptr;
+
+	File file;
+	AudioBuffer<float> buffer;
+	double sampleRate;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioCue)
+};
+
+class AudioStreamManager :
+	public AsyncUpdater
+{
+public:
+	juce_DeclareSingleton(AudioStreamManager, true)
+	AudioStreamManager();
+	~AudioStreamManager();
+
+	AudioFormatManager formatManager;
+	TimeSliceThread readAheadThread;
+
+	CriticalSection preloadLock;
+	ReferenceCountedArray<AudioCue> cues;
+
+	class PreloadListener
+	{
+	public:
+		virtual ~PreloadListener() {}
+		//Called on the message thread, the listener owns the reader. nullptr if the file could not be preloaded
+		virtual void preloadFinished(const File& file, AudioFormatReader* reader) = 0;
+	};
+
+	/*
+		Preloading job, run by slices on the read-ahead thread so neither the message thread nor the other players wait for it :
+		compressed files are decoded to the cache file a block at a time, then the file is mapped and its pages touched a few at a time.
+	*/
+	class PreloadJob :
+		public TimeSliceClient
+	{
+	public:
+		PreloadJob(AudioStreamManager* manager, const File& file, PreloadListener* listener);
+		~PreloadJob();
+
+		AudioStreamManager* manager;
+		File file;
+		PreloadListener* listener;
+
+		File cacheFile;
+		File tmpFile;
+		std::unique_ptr<AudioFormatReader> sourceReader;
+		std::unique_ptr<AudioFormatWriter> writer;
+		int64 decodePosition;
+
+		std::unique_ptr<MemoryMappedAudioFormatReader> reader;
+		int64 touchPosition;
+		int64 samplesPerPage;
+
+		std::atomic<bool> isFinished;
+
+		int useTimeSlice() override;
+
+	private:
+		bool decodeNextBlock();
+		bool mapFile();
+		void finish(bool success);
+	};
+
+	OwnedArray<PreloadJob> preloadJobs;
+
+	//Returns a reader streaming the file from disk. The caller owns the reader
+	AudioFormatReader* createReaderFor(const File& file);
+	static bool isPreloaded(AudioFormatReader* reader);
+
+	//Preloads the file on the read-ahead thread, the listener gets a memory mapped reader when done
+	void preload(const File& file, PreloadListener* listener);
+	//Message thread only, once it returns the listener won't be called anymore
+	void cancelPreloads(PreloadListener* listener);
+
+	//Returns the decoded cue for the file, decoding it if no one uses it yet. nullptr if the file can't be read or is too long to be kept in memory
+	AudioCue::Ptr getCue(const File& file);
+	void releaseUnusedCues();
+
+	static File getPCMCacheDirectory();
+	File getPCMCacheFile(const File& file);
+	//Removes unfinished cache files and the least recently used ones above AUDIO_PCM_CACHE_MAX_SIZE
+	void cleanPCMCache(const File& fileToKeep = File());
+
+	void handleAsyncUpdate() override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioStreamManager)
+};
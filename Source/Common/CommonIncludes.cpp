@@ -10,6 +10,12 @@
 
 #include "CommonIncludes.h"
 
+#include "Scheduling/EventTimestamp.cpp"
+#include "Scheduling/EventScheduler.cpp"
+#include "Scheduling/PropagationBatch.cpp"
+#include "Audio/AudioEnvelopeManager.cpp"
+#include "Audio/AudioStreamManager.cpp"
+
 #include "DMX/DMXManager.cpp"
 #include "DMX/device/DMXDevice.cpp"
 #include "DMX/device/DMXSerialDevice.cpp"
@@ -17,6 +23,7 @@
 #include "DMX/device/DMXEnttecProDevice.cpp"
 #include "DMX/device/DMXOpenUSBDevice.cpp"
 #include "DMX/device/DMXSACNDevice.cpp"
+#include "DMX/recorder/DMXRecording.cpp"
 
 #include "MIDI/MIDIDevice.cpp"
 #include "MIDI/MIDIDeviceParameter.cpp"
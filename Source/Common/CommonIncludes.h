@@ -17,6 +17,12 @@
 #include "Serial/SerialManager.h"
 #include "Serial/SerialDeviceParameter.h"
 
+#include "Scheduling/EventTimestamp.h"
+#include "Scheduling/EventScheduler.h"
+#include "Scheduling/PropagationBatch.h"
+#include "Audio/AudioEnvelopeManager.h"
+#include "Audio/AudioStreamManager.h"
+
 #include "DMX/DMXManager.h"
 #include "DMX/device/DMXDevice.h"
 #include "DMX/device/DMXSerialDevice.h"
@@ -24,6 +30,7 @@
 #include "DMX/device/DMXEnttecProDevice.h"
 #include "DMX/device/DMXOpenUSBDevice.h"
 #include "DMX/device/DMXSACNDevice.h"
+#include "DMX/recorder/DMXRecording.h"
 
 #include "MIDI/MIDIDevice.h"
 #include "MIDI/MIDIManager.h"
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    DMXRecording.cpp
+    Created: 18 Oct 2026 10:12:31am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+DMXRecordingWriter::DMXRecordingWriter(const File& file, int numChannels, double chunkLength) :
+	file(file),
+	numChannels(jlimit(1, 512, numChannels)),
+	chunkLength(chunkLength),
+	currentChunk({ 0, 0, 0, 0, 0 }),
+	numFrames(0),
+	lastTime(0)
+{
+	lastFrame.calloc(this->numChannels);
+
+	file.deleteFile();
+	stream.reset(file.createOutputStream());
+	if (stream == nullptr || stream->failedToOpen())
+	{
+		LOGERROR("Could not create DMX recording file " << file.getFullPathName());
+		stream.reset();
+		return;
+	}
+
+	writeHeader(0); //index offset is written on finish
+}
+
+DMXRecordingWriter::~DMXRecordingWriter()
+{
+	finish();
+}
+
+void DMXRecordingWriter::addFrame(double time, const uint8* values, int numValues)
+{
+	GenericScopedLock lock(writerLock);
+	if (stream == nullptr) return;
+
+	time = jmax(time, lastTime); //keep timestamps monotonic so the index stays searchable
+
+	if (currentChunk.numFrames > 0 && time - currentChunk.startTime >= chunkLength) flushChunk();
+
+	int numToWrite = jmin(numValues, numChannels);
+	chunkData.writeDouble(time);
+
+	if (currentChunk.numFrames == 0)
+	{
+		memcpy(lastFrame.get(), values, numToWrite);
+		chunkData.writeShort((short)DMX_RECORDING_KEYFRAME);
+		chunkData.write(lastFrame.get(), numChannels);
+		currentChunk.startTime = time;
+	}
+	else
+	{
+		int numChanges = 0;
+		for (int i = 0; i < numToWrite; ++i) if (values[i] != lastFrame[i]) numChanges++;
+
+		chunkData.writeShort((short)numChanges);
+		for (int i = 0; i < numToWrite; ++i)
+		{
+			if (values[i] == lastFrame[i]) continue;
+			chunkData.writeShort((short)i);
+			chunkData.writeByte((char)values[i]);
+			lastFrame[i] = values[i];
+		}
+	}
+
+	currentChunk.endTime = time;
+	currentChunk.numFrames++;
+	numFrames++;
+	lastTime = time;
+}
+
+void DMXRecordingWriter::finish()
+{
+	GenericScopedLock lock(writerLock);
+	if (stream == nullptr) return;
+
+	flushChunk();
+
+	int64 indexOffset = stream->getPosition();
+	for (auto& c : chunks)
+	{
+		stream->writeDouble(c.startTime);
+		stream->writeDouble(c.endTime);
+		stream->writeInt64(c.offset);
+		stream->writeInt(c.compressedSize);
+		stream->writeInt(c.numFrames);
+	}
+
+	stream->setPosition(0);
+	writeHeader(indexOffset);
+	stream->flush();
+	stream.reset();
+}
+
+void DMXRecordingWriter::flushChunk()
+{
+	if (currentChunk.numFrames == 0) return;
+
+	currentChunk.offset = stream->getPosition();
+	{
+		GZIPCompressorOutputStream zipStream(*stream, 6);
+		zipStream.write(chunkData.getData(), chunkData.getDataSize());
+	}
+	currentChunk.compressedSize = (int)(stream->getPosition() - currentChunk.offset);
+
+	chunks.add(currentChunk);
+	chunkData.reset();
+	currentChunk = { 0, 0, 0, 0, 0 };
+}
+
+void DMXRecordingWriter::writeHeader(int64 indexOffset)
+{
+	stream->writeInt((int)DMX_RECORDING_MAGIC);
+	stream->writeInt(DMX_RECORDING_VERSION);
+	stream->writeInt(numChannels);
+	stream->writeInt(chunks.size());
+	stream->writeInt64(numFrames);
+	stream->writeInt64(indexOffset);
+}
+
+
+
+DMXRecordingReader::DMXRecordingReader(const File& file) :
+	file(file),
+	numChannels(0),
+	numFrames(0),
+	cachedChunk(-1),
+	cachedFrame(-1)
+{
+	if (!file.existsAsFile()) return;
+
+	mappedFile.reset(new MemoryMappedFile(file, MemoryMappedFile::readOnly));
+	if (mappedFile->getData() == nullptr || mappedFile->getSize() < DMX_RECORDING_HEADER_SIZE)
+	{
+		mappedFile.reset();
+		return;
+	}
+
+	MemoryInputStream header(mappedFile->getData(), DMX_RECORDING_HEADER_SIZE, false);
+	if ((uint32)header.readInt() != DMX_RECORDING_MAGIC || header.readInt() > DMX_RECORDING_VERSION)
+	{
+		LOGERROR("File " << file.getFileName() << " is not a valid DMX recording");
+		mappedFile.reset();
+		return;
+	}
+
+	numChannels = jlimit(1, 512, header.readInt());
+	int numChunks = header.readInt();
+	numFrames = header.readInt64();
+	int64 indexOffset = header.readInt64();
+
+	const int indexEntrySize = 32;
+	if (indexOffset < DMX_RECORDING_HEADER_SIZE || indexOffset + (int64)numChunks * indexEntrySize > (int64)mappedFile->getSize())
+	{
+		LOGERROR("DMX recording " << file.getFileName() << " is incomplete");
+		mappedFile.reset();
+		return;
+	}
+
+	MemoryInputStream index((const char*)mappedFile->getData() + indexOffset, (size_t)numChunks * indexEntrySize, false);
+	for (int i = 0; i < numChunks; ++i)
+	{
+		DMXRecordingWriter::ChunkInfo c;
+		c.startTime = index.readDouble();
+		c.endTime = index.readDouble();
+		c.offset = index.readInt64();
+		c.compressedSize = index.readInt();
+		c.numFrames = index.readInt();
+		chunks.add(c);
+	}
+}
+
+DMXRecordingReader::~DMXRecordingReader()
+{
+}
+
+double DMXRecordingReader::getLength() const
+{
+	return chunks.isEmpty() ? 0 : chunks.getLast().endTime;
+}
+
+int DMXRecordingReader::getChunkIndexForTime(double time) const
+{
+	//last chunk that starts before or at time
+	int low = 0;
+	int high = chunks.size() - 1;
+	int result = 0;
+	while (low <= high)
+	{
+		int mid = (low + high) / 2;
+		if (chunks.getReference(mid).startTime <= time)
+		{
+			result = mid;
+			low = mid + 1;
+		}
+		else high = mid - 1;
+	}
+
+	return result;
+}
+
+bool DMXRecordingReader::getFrameAtTime(double time, uint8* dest, bool forceOutput)
+{
+	if (!isValid()) return false;
+
+	int chunkIndex = getChunkIndexForTime(time);
+	if (chunkIndex != cachedChunk)
+	{
+		if (!decodeChunk(chunkIndex)) return false;
+		cachedFrame = -1;
+	}
+
+	int frameIndex = 0;
+	int numCached = cachedTimes.size();
+	if (numCached == 0) return false;
+
+	if (cachedFrame >= 0 && cachedTimes[cachedFrame] <= time)
+	{
+		//playing forward, walk from the last frame
+		frameIndex = cachedFrame;
+		while (frameIndex < numCached - 1 && cachedTimes[frameIndex + 1] <= time) frameIndex++;
+	}
+	else
+	{
+		frameIndex = (int)(std::upper_bound(cachedTimes.begin(), cachedTimes.end(), time) - cachedTimes.begin()) - 1;
+		frameIndex = jmax(frameIndex, 0);
+	}
+
+	if (frameIndex == cachedFrame && !forceOutput) return false;
+	cachedFrame = frameIndex;
+
+	memcpy(dest, cachedFrames.get() + (size_t)frameIndex * numChannels, numChannels);
+	return true;
+}
+
+bool DMXRecordingReader::decodeChunk(int index)
+{
+	cachedChunk = -1;
+	cachedTimes.clearQuick();
+
+	const DMXRecordingWriter::ChunkInfo& c = chunks.getReference(index);
+	if (c.offset + c.compressedSize > (int64)mappedFile->getSize()) return false;
+
+	cachedFrames.malloc((size_t)c.numFrames * numChannels);
+
+	MemoryInputStream* source = new MemoryInputStream((const char*)mappedFile->getData() + c.offset, (size_t)c.compressedSize, false);
+	GZIPDecompressorInputStream zipStream(source, true);
+
+	for (int i = 0; i < c.numFrames; ++i)
+	{
+		if (zipStream.isExhausted()) return false;
+
+		uint8* frame = cachedFrames.get() + (size_t)i * numChannels;
+		cachedTimes.add(zipStream.readDouble());
+
+		int numChanges = (uint16)zipStream.readShort();
+		if (numChanges == DMX_RECORDING_KEYFRAME)
+		{
+			zipStream.read(frame, numChannels);
+			continue;
+		}
+
+		if (i == 0) return false; //each chunk must start with a keyframe
+
+		memcpy(frame, frame - numChannels, numChannels);
+		for (int j = 0; j < numChanges; ++j)
+		{
+			int channel = (uint16)zipStream.readShort();
+			uint8 value = (uint8)zipStream.readByte();
+			if (channel < numChannels) frame[channel] = value;
+		}
+	}
+
+	cachedChunk = index;
+	return true;
+}
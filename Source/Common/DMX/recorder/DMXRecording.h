@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    DMXRecording.h
+    Created: 18 Oct 2026 10:12:31am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	DMX recording file layout (little endian) :
+
+	Header    : magic "CDMX", version, numChannels, numChunks, numFrames (int64), indexOffset (int64)
+	Chunks    : zlib-compressed frame data. Each chunk starts with a keyframe so it can be decoded on its own.
+				Frame : time (double), numChanges (uint16), then either a full keyframe (numChanges == DMX_RECORDING_KEYFRAME)
+				or numChanges x (channel (uint16), value (uint8))
+	Index     : numChunks x (startTime (double), endTime (double), offset (int64), compressedSize (int), numFrames (int))
+*/
+
+#define DMX_RECORDING_MAGIC ByteOrder::littleEndianInt("CDMX")
+#define DMX_RECORDING_VERSION 1
+#define DMX_RECORDING_HEADER_SIZE 32
+#define DMX_RECORDING_KEYFRAME 0xFFFF
+
+class DMXRecordingWriter
+{
+public:
+	DMXRecordingWriter(const File& file, int numChannels = 512, double chunkLength = 2);
+	~DMXRecordingWriter();
+
+	struct ChunkInfo
+	{
+		double startTime;
+		double endTime;
+		int64 offset;
+		int compressedSize;
+		int numFrames;
+	};
+
+	File file;
+	int numChannels;
+	double chunkLength;
+
+	CriticalSection writerLock;
+	std::unique_ptr<FileOutputStream> stream;
+
+	Array<ChunkInfo> chunks;
+	MemoryOutputStream chunkData;
+	ChunkInfo currentChunk;
+	int64 numFrames;
+
+	HeapBlock<uint8> lastFrame;
+	double lastTime;
+
+	bool isOpened() const { return stream != nullptr; }
+
+	void addFrame(double time, const uint8* values, int numValues);
+	void finish();
+
+private:
+	void flushChunk();
+	void writeHeader(int64 indexOffset);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DMXRecordingWriter)
+};
+
+
+class DMXRecordingReader
+{
+public:
+	DMXRecordingReader(const File& file);
+	~DMXRecordingReader();
+
+	File file;
+	std::unique_ptr<MemoryMappedFile> mappedFile;
+
+	int numChannels;
+	int64 numFrames;
+	Array<DMXRecordingWriter::ChunkInfo> chunks;
+
+	//Only one decoded chunk is kept in memory, playback streams from the mapped file
+	int cachedChunk;
+	int cachedFrame;
+	Array<double> cachedTimes;
+	HeapBlock<uint8> cachedFrames;
+
+	bool isValid() const { return mappedFile != nullptr && chunks.size() > 0; }
+	double getLength() const;
+
+	int getChunkIndexForTime(double time) const;
+	bool getFrameAtTime(double time, uint8* dest, bool forceOutput = false);
+
+private:
+	bool decodeChunk(int index);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DMXRecordingReader)
+};
@@ -127,31 +127,31 @@ void MIDIOutputDevice::close()
 void MIDIOutputDevice::sendNoteOn(int channel, int pitch, int velocity)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::noteOn(channel, pitch, (uint8)velocity));
+	sendMessage(MidiMessage::noteOn(channel, pitch, (uint8)velocity));
 }
 
 void MIDIOutputDevice::sendNoteOff(int channel, int pitch)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::noteOff(channel, pitch));
+	sendMessage(MidiMessage::noteOff(channel, pitch));
 }
 
 void MIDIOutputDevice::sendControlChange(int channel, int number, int value)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::controllerEvent(channel, number, value));
+	sendMessage(MidiMessage::controllerEvent(channel, number, value));
 }
 
 void MIDIOutputDevice::sendProgramChange(int channel, int number)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::programChange(channel, number));
+	sendMessage(MidiMessage::programChange(channel, number));
 }
 
 void MIDIOutputDevice::sendSysEx(Array<uint8> data)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::createSysExMessage(data.getRawDataPointer(), data.size()));
+	sendMessage(MidiMessage::createSysExMessage(data.getRawDataPointer(), data.size()));
 }
 
 void MIDIOutputDevice::sendFullframeTimecode(int hours, int minutes, int seconds, int frames, MidiMessage::SmpteTimecodeType timecodeType)
@@ -175,17 +175,28 @@ void MIDIOutputDevice::sendMidiMachineControlCommand(MidiMessage::MidiMachineCon
 void MIDIOutputDevice::sendPitchWheel(int channel, int value)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::pitchWheel(channel, value));
+	sendMessage(MidiMessage::pitchWheel(channel, value));
 }
 
 void MIDIOutputDevice::sendChannelPressure(int channel, int value)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::channelPressureChange(channel, value));
+	sendMessage(MidiMessage::channelPressureChange(channel, value));
 }
 
 void MIDIOutputDevice::sendAfterTouch(int channel, int note, int value)
 {
 	if (device == nullptr) return;
-	device->sendMessageNow(MidiMessage::aftertouchChange(channel, note, value));
+	sendMessage(MidiMessage::aftertouchChange(channel, note, value));
+}
+
+void MIDIOutputDevice::sendMessage(const MidiMessage& m)
+{
+	WeakReference<MIDIOutputDevice> ref(this);
+	if (EventTimestamp::scheduleAtTimestamp([ref, m]()
+		{
+			if (ref != nullptr && ref->device != nullptr) ref->device->sendMessageNow(m);
+		})) return;
+
+	device->sendMessageNow(m);
 }
\ No newline at end of file
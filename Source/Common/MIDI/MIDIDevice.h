@@ -86,5 +86,11 @@ public:
 	void sendChannelPressure(int channel, int value);
 	void sendAfterTouch(int channel, int note, int value);
 
+	//Sends now, or at the current EventTimestamp if there is one
+	void sendMessage(const MidiMessage& m);
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MIDIOutputDevice)
+
+private:
+	JUCE_DECLARE_WEAK_REFERENCEABLE(MIDIOutputDevice)
 };
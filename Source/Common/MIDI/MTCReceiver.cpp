@@ -10,7 +10,16 @@
 
 MTCReceiver::MTCReceiver(MIDIInputDevice* device) :
 	isPlaying(false),
+	isLocked(false),
 	hours(0), minutes(0), seconds(0), frames(0), type(MidiMessage::SmpteTimecodeType::fps30),
+	divider(30),
+	hasFullSet(false),
+	quarterFrameTime(0),
+	estTime(0),
+	estStamp(0),
+	estRate(1),
+	lastQuarterFrameStamp(0),
+	freewheelTime(.2),
 	device(nullptr)
 {
 	MIDIManager::getInstance()->addMIDIManagerListener(this);
@@ -45,23 +54,71 @@ double MTCReceiver::getTime()
 	return (double)(hours * 3600 + minutes * 60 + seconds) + (frames * 1.0 / divider);
 }
 
-void MTCReceiver::fullFrameTimecodeReceived(const MidiMessage& m)
+double MTCReceiver::getEstimatedTime(double stamp) const
+{
+	if (!isLocked) return getTime();
+	return estTime + estRate * (stamp - estStamp) / 1000.0;
+}
+
+void MTCReceiver::setFreewheelTime(double time)
+{
+	freewheelTime = jmax(time, 2.0 / divider);
+}
+
+void MTCReceiver::setDivider()
 {
-	m.getFullFrameParameters(hours, minutes, seconds, frames, type);
 	switch (type)
 	{
-	case MidiMessage::fps24: divider = 24;
-	case MidiMessage::fps25: divider = 25;
-	case MidiMessage::fps30: divider = 30;
-	case MidiMessage::fps30drop: divider = 29.997;
+	case MidiMessage::fps24: divider = 24; break;
+	case MidiMessage::fps25: divider = 25; break;
+	case MidiMessage::fps30drop: divider = 29.97; break;
+	case MidiMessage::fps30:
+	default: divider = 30; break;
+	}
+}
+
+void MTCReceiver::updateEstimator(double stamp, double time)
+{
+	if (isLocked)
+	{
+		double dt = (stamp - estStamp) / 1000.0;
+		double predicted = estTime + estRate * dt;
+		double error = time - predicted;
+
+		if (dt > 0 && dt < freewheelTime && fabs(error) < relockThresholdFrames / divider)
+		{
+			estTime = predicted + chaseAlpha * error;
+			estRate = jlimit(.5, 2.0, estRate + chaseBeta * error / dt);
+			estStamp = stamp;
+			return;
+		}
 	}
 
+	//first sample, dropout or jump in the master timecode
+	estTime = time;
+	estStamp = stamp;
+	estRate = 1;
+	isLocked = true;
+}
+
+void MTCReceiver::fullFrameTimecodeReceived(const MidiMessage& m)
+{
+	m.getFullFrameParameters(hours, minutes, seconds, frames, type);
+	setDivider();
+
+	//a full frame is a locate, the next quarter-frames restart the estimator
+	isLocked = false;
+	hasFullSet = false;
+
 	mtcListeners.call(&MTCListener::mtcTimeUpdated, true);
 
 }
 
 void MTCReceiver::quarterFrameTimecodeReceived(const MidiMessage& m)
 {
+	double stamp = Time::getMillisecondCounterHiRes();
+	lastQuarterFrameStamp = stamp;
+
 	int piece = m.getQuarterFrameSequenceNumber();
 	pieces[piece] = m.getQuarterFrameValue();
 
@@ -71,29 +128,35 @@ void MTCReceiver::quarterFrameTimecodeReceived(const MidiMessage& m)
 		seconds = (pieces[(int)Piece::SecondLSB] & 0x0F) | ((pieces[(int)Piece::SecondMSB] & 0x03) << 4);
 		minutes = (pieces[(int)Piece::MinuteLSB] & 0x0F) | ((pieces[(int)Piece::MinuteMSB] & 0x03) << 4);
 		hours = (pieces[(int)Piece::HourLSB] & 0x0F) | ((pieces[(int)Piece::RateAndHourMSB] & 0x01) << 4);
-		MidiMessage::SmpteTimecodeType newType = (MidiMessage::SmpteTimecodeType)(pieces[(int)Piece::RateAndHourMSB] & 0x03);
+		MidiMessage::SmpteTimecodeType newType = (MidiMessage::SmpteTimecodeType)((pieces[(int)Piece::RateAndHourMSB] >> 1) & 0x03);
 
 		if (type != newType)
 		{
 			type = newType;
-			switch (type)
-			{
-			case MidiMessage::fps24: divider = 24;
-			case MidiMessage::fps25: divider = 25;
-			case MidiMessage::fps30: divider = 30;
-			case MidiMessage::fps30drop: divider = 29.997;
-			}
+			setDivider();
 		}
 
+		//The decoded timecode is the one of the first piece of the series, we are now 7 quarter-frames later
+		quarterFrameTime = getTime() + 7 / (4 * divider);
+		hasFullSet = true;
+
 		if (!isPlaying)
 		{
 			isPlaying = true;
 			mtcListeners.call(&MTCListener::mtcStarted);
+			startTimer(20);
 		}
-
-		startTimerHz(divider /  5);
+	}
+	else if (hasFullSet)
+	{
+		//between two full series, each quarter-frame still gives a position so the estimator gets 4 samples per frame
+		quarterFrameTime += 1 / (4 * divider);
 	}
 
+	if (!hasFullSet) return;
+
+	updateEstimator(stamp, quarterFrameTime);
+
 	mtcListeners.call(&MTCListener::mtcTimeUpdated, false);
 }
 
@@ -104,7 +167,12 @@ void MTCReceiver::midiDeviceInRemoved(MIDIInputDevice* d)
 
 void MTCReceiver::timerCallback()
 {
+	//keep running on the estimated clock until the freewheel time is elapsed
+	if (Time::getMillisecondCounterHiRes() - lastQuarterFrameStamp < freewheelTime * 1000) return;
+
 	isPlaying = false;
+	isLocked = false;
+	hasFullSet = false;
 	mtcListeners.call(&MTCListener::mtcStopped);
 	stopTimer();
 }
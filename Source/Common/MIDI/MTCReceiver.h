@@ -20,6 +20,7 @@ public:
 	~MTCReceiver();
 
 	bool isPlaying;
+	bool isLocked;
 
 	int hours;
 	int minutes;
@@ -40,11 +41,31 @@ public:
 	};
 
 	int pieces[8];
-	
+	bool hasFullSet;
+
+	//Chase estimator, an alpha-beta filter (steady-state Kalman) locked on quarter-frame arrival times.
+	//estTime is the filtered timecode at estStamp (hi-res ms), estRate the master speed relative to our clock
+	double quarterFrameTime;
+	double estTime;
+	double estStamp;
+	double estRate;
+	std::atomic<double> lastQuarterFrameStamp;
+
+	const double chaseAlpha = .1;
+	const double chaseBeta = .005;
+	const double relockThresholdFrames = 2; //above this error the estimator restarts from the incoming timecode
+
+	double freewheelTime; //seconds without quarter-frames before considering the master stopped
 
 	void setDevice(MIDIInputDevice* newDevice);
 
 	double getTime();
+	double getEstimatedTime(double stamp) const;
+	double getRate() const { return estRate; }
+
+	void setFreewheelTime(double time);
+	void setDivider();
+	void updateEstimator(double stamp, double time);
 
 	void fullFrameTimecodeReceived(const MidiMessage &m) override;
 	void quarterFrameTimecodeReceived(const MidiMessage &m) override;
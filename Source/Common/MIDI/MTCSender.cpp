@@ -1,15 +1,20 @@
 #include <math.h>
 
+#if JUCE_LINUX
+#include <time.h>
+#endif
+
 MTCSender::MTCSender(MIDIOutputDevice* device) :
 	Thread("MTC"),
 	device(device),
-	speedFactor(1)
+	speedFactor(1),
+	referenceTime(0),
+	referenceStamp(-1),
+	quarterFrameIndex(0)
 {
 	// In your constructor, you should add any child components, and
 	// initialise any special settings that your component needs.
 	if (device != nullptr) device->open();
-
-	frameTime = (1000.0 / fps / 4) / speedFactor;
 }
 
 MTCSender::~MTCSender()
@@ -31,7 +36,7 @@ void MTCSender::setDevice(MIDIOutputDevice * newDevice)
 void MTCSender::start(double position)
 {
 	setPosition(position);
-	startThread();
+	startThread(Thread::realtimeAudioPriority);
 }
 
 void MTCSender::pause(bool resumeIfAlreadyPaused)
@@ -41,7 +46,7 @@ void MTCSender::pause(bool resumeIfAlreadyPaused)
 		stopThread(10);
 	}
     else if(resumeIfAlreadyPaused)
-        startThread();
+        startThread(Thread::realtimeAudioPriority);
 }
 
 void MTCSender::stop()
@@ -53,70 +58,123 @@ void MTCSender::setPosition(double position, bool fullFrame)
 {
 	if (device == nullptr) return; 
 
-	double unused;
 	lock.enter();
-	m_frame = static_cast<int>(modf(position, &unused) * fps);
-	m_second = static_cast<int>(position) % 60;
-	m_minute = (static_cast<int>(position) / 60) % 60;
-	m_hour = (static_cast<int>(position) / 60 / 60) % 60;
+	quarterFrameIndex = (int64)floor(jmax(0.0, position) * fps + .0001) * 4; //always restart on a frame boundary
 	m_piece = Piece::FrameLSB;
+	updateTimecode();
 	lock.exit();
 
+	setReferenceTime(position);
+
 	if(fullFrame) device->sendFullframeTimecode(m_hour, m_minute, m_second, m_frame, fpsType);
 }
 
 void MTCSender::setSpeedFactor(float speed)
 {
 	speedFactor = speed;
-	frameTime = (1000.0 / fps / 4) / speedFactor;
+}
+
+void MTCSender::setReferenceTime(double time)
+{
+	referenceTime = time;
+	referenceStamp = Time::getMillisecondCounterHiRes();
 }
 
 void MTCSender::run()
 {
-   if (device == nullptr) return;
-   
-   double lastFrameTime = Time::getMillisecondCounterHiRes();
+	if (device == nullptr) return;
 
-   while (!threadShouldExit())
-   {
-	   sleep(1);
+	double nextDeadline = Time::getMillisecondCounterHiRes();
+
+	while (!threadShouldExit())
+	{
+		if (!waitUntil(nextDeadline)) break;
 
-	   double t = Time::getMillisecondCounterHiRes();
-	   if (t < lastFrameTime + frameTime) continue;
+		double correction = 0;
 
-	   lastFrameTime += frameTime;
+		lock.enter();
 
-	   lock.enter();
+		//The timecode of a series is latched when sending the first piece
+		if (m_piece == Piece::FrameLSB) updateTimecode();
 
 		const int value = getValue(m_piece);
 		device->sendQuarterframe(static_cast<int>(m_piece), value);
 
 		m_piece = static_cast<Piece>((static_cast<int>(m_piece) + 1) % 8);
+		quarterFrameIndex++;
 
-		if (++m_quarter >= 4)
-		{
-			m_quarter = 0;
-			if (++m_frame >= fps)
-			{
-				m_frame = 0;
-				if (++m_second >= 60)
-				{
-					m_second = 0;
-					if (++m_minute >= 60)
-					{
-						m_minute = 0;
-						if (++m_hour >= 24)
-						{
-							m_hour = 0;
-						}
-					}
-				}
-			}
-		}
+		if (m_piece == Piece::FrameLSB) correction = getDriftCorrection(nextDeadline);
 
 		lock.exit();
-   }
 
+		float speed = jmax(speedFactor.load(), .01f);
+		nextDeadline += (1000.0 / fps / 4) / speed + correction;
+
+		//If the thread has been stalled for more than a frame, don't try to catch up with a burst of quarter-frames
+		double now = Time::getMillisecondCounterHiRes();
+		if (now - nextDeadline > 1000.0 / fps) nextDeadline = now;
+	}
+}
+
+bool MTCSender::waitUntil(double deadline)
+{
+	//Sleep in small absolute slices so stopThread is honored quickly whatever the speed factor
+	const double maxSlice = 5;
+
+	while (!threadShouldExit())
+	{
+		double now = Time::getMillisecondCounterHiRes();
+		double remaining = deadline - now;
+		if (remaining <= 0) return true;
+
+		double slice = jmin(remaining, maxSlice);
+
+#if JUCE_LINUX
+		timespec target;
+		clock_gettime(CLOCK_MONOTONIC, &target);
+		int64 targetNanos = (int64)target.tv_sec * 1000000000 + target.tv_nsec + (int64)(slice * 1000000);
+		target.tv_sec = (time_t)(targetNanos / 1000000000);
+		target.tv_nsec = (long)(targetNanos % 1000000000);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {}
+#else
+		//Coarse wait for most of the time, then yield for the last millisecond to get under the scheduler granularity
+		if (slice > 1.5) wait((int)(slice - 1));
+		else Thread::yield();
+#endif
+	}
+
+	return false;
+}
+
+double MTCSender::getDriftCorrection(double now)
+{
+	double stamp = referenceStamp.load();
+	if (stamp < 0) return 0;
+
+	float speed = jmax(speedFactor.load(), .01f);
+	double expected = referenceTime.load() + (now - stamp) / 1000.0 * speed;
+	double current = (quarterFrameIndex - 1) / (fps * 4.0); //the quarter-frame that was due at now, the index already points to the next one
+	double drift = expected - current; //positive if we are late on the reference clock
+
+	if (fabs(drift) > 2.0 / fps)
+	{
+		//too far, jump to the reference on the next series
+		quarterFrameIndex = (int64)floor(jmax(0.0, expected) * fps + .0001) * 4;
+		return 0;
+	}
+
+	return -drift * 1000 * driftCorrectionFactor / speed;
+}
+
+void MTCSender::updateTimecode()
+{
+	int64 frameIndex = (quarterFrameIndex / 4) % ((int64)24 * 3600 * fps);
+	int64 totalSeconds = frameIndex / fps;
+
+	m_frame = (int)(frameIndex % fps);
+	m_second = (int)(totalSeconds % 60);
+	m_minute = (int)((totalSeconds / 60) % 60);
+	m_hour = (int)(totalSeconds / 3600);
 }
 
 int MTCSender::getValue(Piece piece)
@@ -1,6 +1,6 @@
 #pragma once
 
-class MTCSender : 
+class MTCSender :
 	Thread
 {
 public:
@@ -15,6 +15,9 @@ public:
     void setPosition(double position, bool fullFrame = false);
 	void setSpeedFactor(float speed);
 
+	//Time of the clock the generator is locked to (the sequence time), used for drift correction
+	void setReferenceTime(double time);
+
 	MIDIOutputDevice* device;
 
 // Used only in separate thread!
@@ -33,19 +36,25 @@ private:
     void run() override;
     int getValue(Piece piece);
 
+	bool waitUntil(double deadline);
+	double getDriftCorrection(double now);
+	void updateTimecode();
+
 	SpinLock lock;
 
-	float currentPosition;
-	float speedFactor;
+	std::atomic<float> speedFactor;
 
-	double frameTime;
-	double lastFrameSendTime;
+	//Reference clock, referenceStamp is the hi-res counter value when referenceTime was set, -1 if not set
+	std::atomic<double> referenceTime;
+	std::atomic<double> referenceStamp;
 
 	const int fps = 30;
 	const MidiMessage::SmpteTimecodeType fpsType = MidiMessage::SmpteTimecodeType::fps30;
+	const double driftCorrectionFactor = .1; //part of the drift compensated at each full quarter-frame series
+
+	int64 quarterFrameIndex; //quarter-frames since 00:00:00:00, timecode is derived from it so there is no accumulated float error
 
     Piece m_piece{Piece::FrameLSB};
-    int m_quarter{0};
     int m_frame{0};
     int m_second{0};
     int m_minute{0};
@@ -230,11 +230,13 @@ void ParameterLink::updateMappingInputValue(var value, int multiplexIndex)
 
 	if (linkType == MAPPING_INPUT && !isMultiplexed()) parameter->setValue(linkedInputValue);
 
+	parameterLinkListeners.call(&ParameterLinkListener::linkedValueUpdated, this, multiplexIndex);
 	paramLinkNotifier.addMessage(new ParameterLinkEvent(ParameterLinkEvent::INPUT_VALUE_UPDATED, this)); //only for preview
 }
 
 void ParameterLink::listItemUpdated(int multiplexIndex)
 {
+	parameterLinkListeners.call(&ParameterLinkListener::linkedValueUpdated, this, multiplexIndex);
 	paramLinkNotifier.addMessage(new ParameterLinkEvent(ParameterLinkEvent::LIST_ITEM_UPDATED, this)); //only for preview
 }
 
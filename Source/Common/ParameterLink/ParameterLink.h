@@ -78,6 +78,7 @@ public:
     public:
         virtual ~ParameterLinkListener() {}
         virtual void linkUpdated(ParameterLink * pLink) {}
+        virtual void linkedValueUpdated(ParameterLink * pLink, int multiplexIndex) {} //list item or mapping input changed, the link itself is the same
     };
 
     ListenerList<ParameterLinkListener> parameterLinkListeners;
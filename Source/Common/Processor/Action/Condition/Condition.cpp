@@ -22,6 +22,7 @@ Condition::Condition(const String& n, var params, Multiplex * multiplex) :
 
 	isValids.resize(getMultiplexCount());
 	isValids.fill(false);
+	countedValids.resize(getMultiplexCount());
 }
 
 Condition::~Condition()
@@ -32,6 +33,8 @@ void Condition::multiplexCountChanged()
 {
 	isValids.resize(getMultiplexCount());
 	isValids.fill(false);
+	countedValids.resize(getMultiplexCount());
+	countedValids.fill(false);
 }
 
 void Condition::multiplexPreviewIndexChanged()
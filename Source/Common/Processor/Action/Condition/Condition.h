@@ -20,6 +20,7 @@ public:
 
 	bool forceDisabled;
 	Array<bool> isValids; //this could be simplified for non-iterative condition
+	Array<bool> countedValids; //validity as last counted by the parent manager, see ConditionManager::updateValidCount
 
 	virtual void multiplexCountChanged() override;
 	virtual void multiplexPreviewIndexChanged() override;
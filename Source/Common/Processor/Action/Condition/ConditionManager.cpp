@@ -13,6 +13,8 @@ ConditionManager::ConditionManager(Multiplex * multiplex) :
 	BaseManager<Condition>("Conditions"),
 	activateDef(nullptr),
 	deactivateDef(nullptr),
+	numEnabledConditions(-1),
+	isBatchPending(false),
     forceDisabled(false),
 	isCheckingOtherConditionsWithSameSource(false),
 	conditionManagerAsyncNotifier(10)
@@ -21,8 +23,14 @@ ConditionManager::ConditionManager(Multiplex * multiplex) :
 	selectItemWhenCreated = false;
 
 	isValids.resize(getMultiplexCount());
-	validationProgresses.resize(getMultiplexCount());
+	validationWaitings.resize(getMultiplexCount());
+	validationStartTimes.resize(getMultiplexCount());
+	validationTasks.resize(getMultiplexCount());
+	validationDispatchPending.resize(getMultiplexCount());
 	sequentialConditionIndices.resize(getMultiplexCount());
+	validConditionCounts.resize(getMultiplexCount());
+	batchDirtyIndices.resize(getMultiplexCount());
+	batchDispatchOnChangeOnly.resize(getMultiplexCount());
 
 	managerFactory = &factory;
 	factory.defs.add(MultiplexTargetDefinition<Condition>::createDef<StandardCondition>("", StandardCondition::getTypeStringStatic(false), multiplex));
@@ -48,17 +56,37 @@ SEQUENTIAL will check the first, and when it gets validated, will check the next
 
 ConditionManager::~ConditionManager()
 {
+	if (EventScheduler* scheduler = EventScheduler::getInstanceWithoutCreating()) scheduler->cancelAll(this);
 }
 
 void ConditionManager::multiplexCountChanged()
 {
+	if (EventScheduler* scheduler = EventScheduler::getInstanceWithoutCreating()) scheduler->cancelAll(this);
+
+	{
+		GenericScopedLock lock(validationLock);
+		validationStartTimes.resize(getMultiplexCount());
+		validationTasks.resize(getMultiplexCount());
+		validationDispatchPending.resize(getMultiplexCount());
+		validationStartTimes.fill(0);
+		validationTasks.fill(0);
+		validationDispatchPending.fill(false);
+	}
+
 	isValids.resize(getMultiplexCount());
-	validationProgresses.resize(getMultiplexCount());
+	validationWaitings.resize(getMultiplexCount());
 	sequentialConditionIndices.resize(getMultiplexCount());
 
 	isValids.fill(false);
-	validationProgresses.fill(0);
+	validationWaitings.fill(false);
 	sequentialConditionIndices.fill(0);
+
+	GenericScopedLock lock(countLock);
+	validConditionCounts.resize(getMultiplexCount());
+	batchDirtyIndices.resize(getMultiplexCount());
+	batchDispatchOnChangeOnly.resize(getMultiplexCount());
+	batchDirtyIndices.fill(false);
+	invalidateConditionCounts();
 }
 
 void ConditionManager::multiplexPreviewIndexChanged()
@@ -93,6 +121,7 @@ void ConditionManager::addItemInternal(Condition * c, var data)
 	c->setForceDisabled(forceDisabled);
 	c->addConditionListener(this);
 	conditionOperator->hideInEditor = items.size() <= 1;
+	invalidateConditionCounts();
 	StandardCondition* sc = dynamic_cast<StandardCondition*>(c);
 	if (sc != nullptr)
 	{
@@ -105,6 +134,7 @@ void ConditionManager::removeItemInternal(Condition * c)
 {
 	c->removeConditionListener(this);
 	conditionOperator->hideInEditor = items.size() <= 1;
+	invalidateConditionCounts();
 	
 	sequentialConditionIndices.fill(0);
 	conditionManagerAsyncNotifier.addMessage(new ConditionManagerEvent(ConditionManagerEvent::SEQUENTIAL_CONDITION_INDEX_CHANGED, this));
@@ -132,9 +162,16 @@ void ConditionManager::setForceDisabled(bool value, bool force)
 
 void ConditionManager::setValid(int multiplexIndex, bool value, bool dispatchOnlyOnValidationChange)
 {
+	dispatchPendingValidation(multiplexIndex);
+
 	if (isValids[multiplexIndex] == value && dispatchOnlyOnValidationChange) return;
 	isValids.set(multiplexIndex, value);
 
+	validChanged(multiplexIndex, dispatchOnlyOnValidationChange);
+}
+
+void ConditionManager::validChanged(int multiplexIndex, bool dispatchOnlyOnValidationChange)
+{
 	dispatchConditionValidationChanged(multiplexIndex, dispatchOnlyOnValidationChange);
 	
 	if (isValids[multiplexIndex] && conditionOperator->getValueDataAsEnum<ConditionOperator>() == SEQUENTIAL)
@@ -155,10 +192,82 @@ void ConditionManager::setValid(int multiplexIndex, bool value, bool dispatchOnl
 
 }
 
-void ConditionManager::setValidationProgress(int multiplexIndex, float value)
+void ConditionManager::startValidationWait(int multiplexIndex, double startTime)
+{
+	GenericScopedLock lock(validationLock);
+
+	EventScheduler* scheduler = EventScheduler::getInstance();
+	if (validationTasks[multiplexIndex] != 0) scheduler->cancel(validationTasks[multiplexIndex]);
+
+	validationStartTimes.set(multiplexIndex, startTime);
+	double deadline = startTime + validationTime->floatValue() * 1000;
+	//the validity changes right at the deadline, the consequences run on the message thread as they may be long
+	WeakReference<Inspectable> managerRef(this);
+	validationTasks.set(multiplexIndex, scheduler->scheduleAt(deadline, [this, managerRef, multiplexIndex, startTime]()
+	{
+		if (!validationDeadlineReached(multiplexIndex, startTime)) return;
+		MessageManager::callAsync([this, managerRef, multiplexIndex]()
+		{
+			if (!managerRef.wasObjectDeleted()) dispatchPendingValidation(multiplexIndex);
+		});
+	}, this));
+}
+
+void ConditionManager::stopValidationWait(int multiplexIndex)
+{
+	GenericScopedLock lock(validationLock);
+
+	if (validationTasks[multiplexIndex] != 0)
+	{
+		if (EventScheduler* scheduler = EventScheduler::getInstanceWithoutCreating()) scheduler->cancel(validationTasks[multiplexIndex]);
+	}
+
+	validationStartTimes.set(multiplexIndex, 0);
+	validationTasks.set(multiplexIndex, 0);
+}
+
+bool ConditionManager::validationDeadlineReached(int multiplexIndex, double startTime)
 {
-	validationProgresses.set(multiplexIndex, value);
-	if (!isMultiplexed()) validationProgressFeedback->setValue(value);
+	GenericScopedLock lock(validationLock);
+	if (validationStartTimes[multiplexIndex] != startTime) return false; //restarted or stopped in between
+	validationStartTimes.set(multiplexIndex, 0);
+	validationTasks.set(multiplexIndex, 0);
+
+	if (isValids[multiplexIndex]) return false;
+	isValids.set(multiplexIndex, true);
+	validationDispatchPending.set(multiplexIndex, true);
+	return true;
+}
+
+void ConditionManager::dispatchPendingValidation(int multiplexIndex)
+{
+	{
+		GenericScopedLock lock(validationLock);
+		if (!validationDispatchPending[multiplexIndex]) return;
+		validationDispatchPending.set(multiplexIndex, false);
+	}
+
+	validChanged(multiplexIndex, true);
+}
+
+float ConditionManager::getValidationProgress(int multiplexIndex)
+{
+	double startTime = validationStartTimes[multiplexIndex];
+	if (startTime == 0) return isValids[multiplexIndex] && validationWaitings[multiplexIndex] ? 1 : 0;
+
+	double time = validationTime->floatValue() * 1000;
+	if (time <= 0) return 1;
+	return jlimit<float>(0, 1, (Time::getMillisecondCounterHiRes() - startTime) / time);
+}
+
+void ConditionManager::updateValidationProgressFeedback()
+{
+	validationProgressFeedback->setValue(getValidationProgress(getPreviewIndex()));
+}
+
+bool ConditionManager::isWaitingValidation(int multiplexIndex)
+{
+	return validationStartTimes[multiplexIndex] > 0;
 }
 
 void ConditionManager::setSequentialConditionIndices(int index, int multiplexIndex)
@@ -174,6 +283,78 @@ void ConditionManager::forceCheck()
 	for (auto& i : items) i->forceCheck();
 }
 
+void ConditionManager::invalidateConditionCounts()
+{
+	GenericScopedLock lock(countLock);
+	numEnabledConditions = -1;
+}
+
+void ConditionManager::updateConditionCounts()
+{
+	GenericScopedLock lock(countLock);
+
+	int multiplexCount = getMultiplexCount();
+	validConditionCounts.resize(multiplexCount);
+	validConditionCounts.fill(0);
+
+	int numEnabled = 0;
+	for (auto& c : items)
+	{
+		c->countedValids.resize(multiplexCount);
+		bool enabled = c->enabled->boolValue();
+		if (enabled) numEnabled++;
+
+		for (int i = 0; i < multiplexCount; i++)
+		{
+			bool v = enabled && c->getIsValid(i);
+			c->countedValids.set(i, v);
+			if (v) validConditionCounts.getReference(i)++;
+		}
+	}
+
+	numEnabledConditions = numEnabled;
+}
+
+void ConditionManager::updateValidCount(Condition* c, int multiplexIndex)
+{
+	GenericScopedLock lock(countLock);
+
+	if (numEnabledConditions < 0) return; //will be rebuilt on next read
+	if (multiplexIndex < 0 || multiplexIndex >= c->countedValids.size() || multiplexIndex >= validConditionCounts.size())
+	{
+		invalidateConditionCounts();
+		return;
+	}
+
+	bool v = c->enabled->boolValue() && c->getIsValid(multiplexIndex);
+	if (c->countedValids[multiplexIndex] == v) return;
+
+	c->countedValids.set(multiplexIndex, v);
+	validConditionCounts.getReference(multiplexIndex) += v ? 1 : -1;
+}
+
+void ConditionManager::flushBatch()
+{
+	//take the dirty indices under the lock, conditions are checked outside so changes during the check start a new batch
+	Array<int> dirtyIndices;
+	Array<bool> dispatchOnChangeOnly;
+	{
+		GenericScopedLock lock(countLock);
+		if (!isBatchPending) return;
+		isBatchPending = false;
+
+		for (int i = 0; i < batchDirtyIndices.size(); i++)
+		{
+			if (!batchDirtyIndices[i]) continue;
+			batchDirtyIndices.set(i, false);
+			dirtyIndices.add(i);
+			dispatchOnChangeOnly.add(batchDispatchOnChangeOnly[i]);
+		}
+	}
+
+	for (int i = 0; i < dirtyIndices.size(); i++) checkAllConditions(dirtyIndices[i], false, dispatchOnChangeOnly[i]);
+}
+
 void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid, bool dispatchOnlyOnValidationChange, int sourceConditionIndex)
 {
 	bool valid = false;
@@ -200,20 +381,15 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 
 	if (validationTime->floatValue() == 0)
 	{
+		if (isWaitingValidation(multiplexIndex)) stopValidationWait(multiplexIndex);
+		validationWaitings.set(multiplexIndex, valid);
 		setValid(multiplexIndex, valid, dispatchOnlyOnValidationChange);
 	}else if (valid != validationWaitings[multiplexIndex])
 	{
 		validationWaitings.set(multiplexIndex, valid);
-		setValidationProgress(multiplexIndex, 0);
 		setValid(multiplexIndex, false);
-		if(!valid)
-		{
-			stopTimer(multiplexIndex);
-		} else
-		{
-			prevTimerTimes.set(multiplexIndex, Time::getMillisecondCounterHiRes() / 1000.0);
-			startTimer(multiplexIndex, 20);
-		}
+		if (!valid) stopValidationWait(multiplexIndex);
+		else startValidationWait(multiplexIndex, Time::getMillisecondCounterHiRes());
 	}
 }
 
@@ -221,8 +397,32 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 
 void ConditionManager::conditionValidationChanged(Condition* c, int multiplexIndex, bool dispatchOnChangeOnly)
 {
+	updateValidCount(c, multiplexIndex);
+
 	if (isCheckingOtherConditionsWithSameSource) return;
 
+	//All the conditions of the changed source are being checked, combine them once at the end. Sequential needs the index of each change
+	if (ConditionSourceIndex::isBatching() && conditionOperator->getValueDataAsEnum<ConditionOperator>() != SEQUENTIAL)
+	{
+		GenericScopedLock lock(countLock);
+		if (multiplexIndex < batchDirtyIndices.size())
+		{
+			if (batchDirtyIndices[multiplexIndex]) batchDispatchOnChangeOnly.set(multiplexIndex, batchDispatchOnChangeOnly[multiplexIndex] && dispatchOnChangeOnly);
+			else
+			{
+				batchDirtyIndices.set(multiplexIndex, true);
+				batchDispatchOnChangeOnly.set(multiplexIndex, dispatchOnChangeOnly);
+			}
+
+			if (!isBatchPending)
+			{
+				isBatchPending = true;
+				ConditionSourceIndex::addToCurrentBatch(this);
+			}
+			return;
+		}
+	}
+
 	if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c))
 	{
 		isCheckingOtherConditionsWithSameSource = true;
@@ -254,28 +454,22 @@ void ConditionManager::onContainerParameterChanged(Parameter * p)
 	else if (p == validationTime)
 	{
 		validationProgressFeedback->setEnabled(validationTime->floatValue() > 0);
+
+		//pending validations keep their start time and get the new deadline, already passed deadlines validate right away
+		for (int i = 0; i < getMultiplexCount(); i++)
+		{
+			if (isWaitingValidation(i)) startValidationWait(i, validationStartTimes[i]);
+		}
 	}
 }
 
-void ConditionManager::timerCallback(int id)
+void ConditionManager::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
 {
-	if (validationTime->floatValue() == 0)
-	{
-		setValid(id, true);
-		stopTimer(id);
-		return;
-	}
-
-	double curTime = Time::getMillisecondCounterHiRes() / 1000.0;
-	float diffProgress = (curTime - prevTimerTimes[id]) / validationTime->floatValue();
-	float progress = validationProgresses[id] + diffProgress;
-	setValidationProgress(id, progress);
-	prevTimerTimes.set(id, curTime);
+	BaseManager::onControllableFeedbackUpdate(cc, c);
 
-	if (validationProgresses[id] >= 1)
+	if (Condition* cd = dynamic_cast<Condition*>(cc))
 	{
-		setValid(id, true);
-		stopTimer(id);
+		if (c == cd->enabled) invalidateConditionCounts();
 	}
 }
 
@@ -286,55 +480,31 @@ void ConditionManager::afterLoadJSONDataInternal()
 
 bool ConditionManager::areAllConditionsValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0;
-	for (auto &c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (!c->getIsValid(multiplexIndex)) return false;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return true;
+	GenericScopedLock lock(countLock);
+	int numEnabled = getNumEnabledConditions();
+	if (numEnabled == 0) return emptyIsValid;
+	return getNumValidConditions(multiplexIndex) == numEnabled;
 }
 
 bool ConditionManager::isAtLeastOneConditionValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0; 
-	for (auto &c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) return true;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return false;
+	GenericScopedLock lock(countLock);
+	if (getNumEnabledConditions() == 0) return emptyIsValid;
+	return getNumValidConditions(multiplexIndex) > 0;
 }
 
 int ConditionManager::getNumEnabledConditions()
 {
-	int result = 0;
-	for (auto &c : items)
-	{
-		if (c->enabled->boolValue()) result++;
-	}
-	return result;
+	GenericScopedLock lock(countLock);
+	if (numEnabledConditions < 0) updateConditionCounts();
+	return numEnabledConditions;
 }
 
 int ConditionManager::getNumValidConditions(int multiplexIndex)
 {
-	int result = 0;
-	for (auto &c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) result++;
-	}
-	return result;
+	GenericScopedLock lock(countLock);
+	if (numEnabledConditions < 0) updateConditionCounts();
+	return validConditionCounts[multiplexIndex];
 }
 
 bool ConditionManager::getIsValid(int multiplexIndex, bool emptyIsValid)
@@ -13,8 +13,7 @@
 class ConditionManager :
 	public MultiplexTarget,
 	public BaseManager<Condition>,
-	public Condition::ConditionListener,
-	public MultiTimer
+	public Condition::ConditionListener
 {
 public:
 	ConditionManager(Multiplex* multiplex);
@@ -32,9 +31,25 @@ public:
 	FloatParameter* validationProgressFeedback;
 
 	Array<bool> isValids;
-	Array<float> validationProgresses;
 	Array<bool> validationWaitings;
-	Array<double> prevTimerTimes;
+
+	//Validation time is handled by the EventScheduler, one task at the deadline instead of a progress timer.
+	//The task sets the validity at the deadline, only the listeners (and the consequences they trigger) are notified on the message thread
+	CriticalSection validationLock;
+	Array<double> validationStartTimes; //Time::getMillisecondCounterHiRes() when the conditions became valid, 0 if not waiting
+	Array<EventScheduler::TaskID> validationTasks;
+	Array<bool> validationDispatchPending; //validated at the deadline, listeners not notified yet
+
+	//Cached results for AND / OR, updated when a condition changes instead of checking all the conditions again
+	//Conditions change from any thread, the counts and the batch state are only accessed under countLock
+	CriticalSection countLock;
+	Array<int> validConditionCounts;
+	int numEnabledConditions; //-1 when counts need to be rebuilt
+
+	//Batched evaluation, when the ConditionSourceIndex checks all the conditions of a source before the managers combine them
+	bool isBatchPending;
+	Array<bool> batchDirtyIndices;
+	Array<bool> batchDispatchOnChangeOnly;
 
 	bool forceDisabled;
 
@@ -52,12 +67,28 @@ public:
 	void setForceDisabled(bool value, bool force = false);
 
 	void setValid(int multiplexIndex, bool value, bool dispatchOnlyOnValidationChange = true);
-	void setValidationProgress(int multiplexIndex, float value);
+	void validChanged(int multiplexIndex, bool dispatchOnlyOnValidationChange);
+
+	void startValidationWait(int multiplexIndex, double startTime);
+	void stopValidationWait(int multiplexIndex);
+	bool validationDeadlineReached(int multiplexIndex, double startTime); //scheduler thread, returns true if it validated
+	void dispatchPendingValidation(int multiplexIndex); //message thread, before any other validity change so listeners see them in order
+
+	//Progress is computed from the start time when asked, UIs showing it call updateValidationProgressFeedback
+	float getValidationProgress(int multiplexIndex);
+	void updateValidationProgressFeedback();
+	bool isWaitingValidation(int multiplexIndex);
 
 	void setSequentialConditionIndices(int index, int multiplexIndex = -1);
 
 	void forceCheck();
 
+	void invalidateConditionCounts();
+	void updateConditionCounts();
+	void updateValidCount(Condition* c, int multiplexIndex);
+
+	void flushBatch();
+
 	void checkAllConditions(int multiplexIndex, bool emptyIsValid = false, bool dispatchOnlyOnValidationChange = true, int sourceConditionIndex = -1);
 
 	bool areAllConditionsValid(int multiplexIndex, bool emptyIsValid = false);
@@ -73,8 +104,7 @@ public:
 	void conditionValidationChanged(Condition*, int multiplexIndex, bool dispatchOnChangeOnly) override;
 
 	void onContainerParameterChanged(Parameter*) override;
-
-	virtual void timerCallback(int id) override;
+	void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
 
 	void afterLoadJSONDataInternal() override;
 
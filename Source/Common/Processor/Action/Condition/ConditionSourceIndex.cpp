@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    ConditionSourceIndex.cpp
+    Created: 18 Oct 2026 9:14:52pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+juce_ImplementSingleton(ConditionSourceIndex)
+
+thread_local Array<WeakReference<Inspectable>>* ConditionSourceIndex::currentBatch = nullptr;
+
+ConditionSourceIndex::ConditionSourceIndex()
+{
+}
+
+ConditionSourceIndex::~ConditionSourceIndex()
+{
+	GenericScopedLock lock(indexLock);
+	while (!entries.isEmpty()) removeEntry(entries.getLast());
+}
+
+void ConditionSourceIndex::registerCondition(StandardCondition* c, Controllable* source)
+{
+	if (source == nullptr) return;
+
+	GenericScopedLock lock(indexLock);
+
+	SourceEntry* e = sourceMap[source];
+	if (e == nullptr)
+	{
+		e = entries.add(new SourceEntry());
+		e->key = source;
+		e->source = source;
+		sourceMap.set(source, e);
+
+		if (source->type == Controllable::TRIGGER) ((Trigger*)source)->addTriggerListener(this);
+		else ((Parameter*)source)->addParameterListener(this);
+		source->addInspectableListener(this);
+	}
+
+	e->conditions.addIfNotAlreadyThere(WeakReference<Inspectable>(c));
+}
+
+void ConditionSourceIndex::unregisterCondition(StandardCondition* c, Controllable* source)
+{
+	if (source == nullptr) return;
+
+	GenericScopedLock lock(indexLock);
+
+	SourceEntry* e = sourceMap[source];
+	if (e == nullptr) return;
+
+	for (int i = e->conditions.size() - 1; i >= 0; i--)
+	{
+		Inspectable* ci = e->conditions.getReference(i).get();
+		if (ci == nullptr || ci == c) e->conditions.remove(i);
+	}
+	if (e->conditions.isEmpty()) removeEntry(e);
+}
+
+void ConditionSourceIndex::removeEntry(SourceEntry* e)
+{
+	if (Controllable* source = e->source.get())
+	{
+		if (source->type == Controllable::TRIGGER) ((Trigger*)source)->removeTriggerListener(this);
+		else ((Parameter*)source)->removeParameterListener(this);
+		source->removeInspectableListener(this);
+	}
+
+	sourceMap.remove(e->key);
+	entries.removeObject(e);
+}
+
+void ConditionSourceIndex::evaluateSource(Controllable* source)
+{
+	Array<WeakReference<Inspectable>> conditions;
+	{
+		GenericScopedLock lock(indexLock);
+		if (SourceEntry* e = sourceMap[source]) conditions = e->conditions;
+	}
+
+	if (conditions.isEmpty()) return;
+
+	//Triggers validate and invalidate right away, they can't wait for the end of a batch
+	if (source->type == Controllable::TRIGGER || conditions.size() == 1)
+	{
+		for (auto& c : conditions)
+		{
+			if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c.get())) sc->sourceUpdated();
+		}
+		return;
+	}
+
+	Array<WeakReference<Inspectable>> batch;
+	Array<WeakReference<Inspectable>>* previousBatch = currentBatch;
+	currentBatch = &batch;
+	for (auto& c : conditions)
+	{
+		if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c.get())) sc->sourceUpdated();
+	}
+	currentBatch = previousBatch;
+
+	for (auto& m : batch)
+	{
+		if (ConditionManager* cdm = dynamic_cast<ConditionManager*>(m.get())) cdm->flushBatch();
+	}
+}
+
+void ConditionSourceIndex::addToCurrentBatch(ConditionManager* manager)
+{
+	jassert(currentBatch != nullptr);
+	currentBatch->add(manager);
+}
+
+void ConditionSourceIndex::parameterValueChanged(Parameter* p)
+{
+	//in a propagation batch, conditions are evaluated once with the final values of all the sources
+	if (PropagationBatch::defer(p, 0, [this, p]() { evaluateSource(p); })) return;
+	evaluateSource(p);
+}
+
+void ConditionSourceIndex::parameterRangeChanged(Parameter* p)
+{
+	Array<WeakReference<Inspectable>> conditions;
+	{
+		GenericScopedLock lock(indexLock);
+		if (SourceEntry* e = sourceMap[p]) conditions = e->conditions;
+	}
+
+	for (auto& c : conditions)
+	{
+		if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c.get())) sc->onExternalParameterRangeChanged(p);
+	}
+}
+
+void ConditionSourceIndex::triggerTriggered(Trigger* t)
+{
+	evaluateSource(t);
+}
+
+void ConditionSourceIndex::inspectableDestroyed(Inspectable* i)
+{
+	GenericScopedLock lock(indexLock);
+	for (auto& e : entries)
+	{
+		if (static_cast<Inspectable*>(e->key) != i) continue;
+		sourceMap.remove(e->key);
+		entries.removeObject(e);
+		return;
+	}
+}
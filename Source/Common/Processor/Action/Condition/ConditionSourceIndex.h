@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ConditionSourceIndex.h
+    Created: 18 Oct 2026 9:14:52pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class StandardCondition;
+class ConditionManager;
+
+/*
+	Reverse index from a source controllable to the standard conditions that check it.
+	Only the index listens to the source, so a change is handled once whatever the number of conditions using it.
+	All these conditions are checked first, then each condition manager that changed combines its conditions once (see ConditionManager::flushBatch).
+*/
+class ConditionSourceIndex :
+	public Parameter::ParameterListener,
+	public Trigger::TriggerListener,
+	public Inspectable::InspectableListener
+{
+public:
+	juce_DeclareSingleton(ConditionSourceIndex, true)
+	ConditionSourceIndex();
+	~ConditionSourceIndex();
+
+	struct SourceEntry
+	{
+		Controllable* key; //only compared, the source may be in its destructor
+		WeakReference<Controllable> source;
+		Array<WeakReference<Inspectable>> conditions; //used outside of the lock, a condition may be deleted meanwhile
+	};
+
+	CriticalSection indexLock;
+	HashMap<Controllable*, SourceEntry*> sourceMap;
+	OwnedArray<SourceEntry> entries;
+
+	void registerCondition(StandardCondition* c, Controllable* source);
+	void unregisterCondition(StandardCondition* c, Controllable* source);
+
+	void evaluateSource(Controllable* source);
+
+	//True while the conditions of a source are checked on this thread, managers then wait for the end of the batch to combine them
+	static bool isBatching() { return currentBatch != nullptr; }
+	static void addToCurrentBatch(ConditionManager* manager);
+
+	void parameterValueChanged(Parameter* p) override;
+	void parameterRangeChanged(Parameter* p) override;
+	void triggerTriggered(Trigger* t) override;
+	void inspectableDestroyed(Inspectable* i) override;
+
+private:
+	void removeEntry(SourceEntry* e);
+
+	static thread_local Array<WeakReference<Inspectable>>* currentBatch;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConditionSourceIndex)
+};
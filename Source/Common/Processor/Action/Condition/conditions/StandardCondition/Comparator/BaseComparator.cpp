@@ -14,8 +14,11 @@ BaseComparator::BaseComparator(Multiplex * multiplex) :
 	ControllableContainer("Comparator"),
 	MultiplexTarget(multiplex),
 	reference(nullptr),
+	currentFunction(-1),
 	comparatorNotifier(5)
 {
+	referenceCache.resize(getMultiplexCount());
+
 	compareFunction = addEnumParameter("Comparison Function", "Decides what function checks the activeness of the condition");
 	compareFunction->hideInEditor = true;
 }
@@ -38,16 +41,27 @@ void BaseComparator::setReferenceParam(Parameter* p)
 	if (reference != nullptr)
 	{
 		addParameter(reference);
-		if (isMultiplexed()) refLink.reset(new ParameterLink(reference, multiplex));
+		if (isMultiplexed())
+		{
+			refLink.reset(new ParameterLink(reference, multiplex));
+			refLink->addParameterLinkListener(this);
+		}
 	}
 
+	invalidateReferenceCache();
+
 	comparatorNotifier.addMessage(new ComparatorEvent(ComparatorEvent::REFERENCE_CHANGED, this));
 }
 
-void BaseComparator::addCompareOption(const String & name, const Identifier & func)
+void BaseComparator::addCompareOption(const String & name, const Identifier & func, int function)
 {
 	compareFunction->addOption(name, var(func.toString()));
-	if (compareFunction->enumValues.size() == 1) currentFunctionId = func.toString();
+	functionCodes.set(func.toString(), function);
+	if (compareFunction->enumValues.size() == 1)
+	{
+		currentFunctionId = func.toString();
+		currentFunction = function;
+	}
 }
 
 
@@ -57,6 +71,69 @@ void BaseComparator::updateReferenceRange(Parameter* sourceParam)
 	else reference->clearRange();
 }
 
+BaseComparator::CachedReference BaseComparator::getReference(int multiplexIndex)
+{
+	GenericScopedLock lock(referenceLock);
+
+	bool hasSlot = isPositiveAndBelow(multiplexIndex, referenceCache.size());
+	if (hasSlot && referenceCache.getReference(multiplexIndex).isValid) return referenceCache.getReference(multiplexIndex);
+
+	CachedReference r;
+	var value = isMultiplexed() && refLink != nullptr ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
+	if (value.isArray())
+	{
+		for (int i = 0; i < jmin(value.size(), 3); i++) r.values[i] = value[i];
+	}
+	else if (value.isBool() || value.isInt() || value.isInt64() || value.isDouble())
+	{
+		r.values[0] = value;
+	}
+	r.data = value;
+
+	if (hasSlot && canCacheReference())
+	{
+		r.isValid = true;
+		referenceCache.set(multiplexIndex, r);
+	}
+
+	return r;
+}
+
+bool BaseComparator::canCacheReference()
+{
+	if (reference == nullptr) return false;
+	if (refLink == nullptr) return true;
+
+	//preset values and string replacements are not notified when they change
+	if (refLink->linkType == ParameterLink::CV_PRESET_PARAM) return false;
+	if (reference->type == Parameter::STRING && refLink->linkType == ParameterLink::NONE && reference->stringValue().contains("{")) return false;
+	return true;
+}
+
+void BaseComparator::invalidateReferenceCache()
+{
+	GenericScopedLock lock(referenceLock);
+	for (auto& r : referenceCache) r.isValid = false;
+}
+
+void BaseComparator::multiplexCountChanged()
+{
+	GenericScopedLock lock(referenceLock);
+	referenceCache.clearQuick();
+	referenceCache.resize(getMultiplexCount());
+}
+
+void BaseComparator::linkUpdated(ParameterLink* pLink)
+{
+	invalidateReferenceCache();
+}
+
+void BaseComparator::linkedValueUpdated(ParameterLink* pLink, int multiplexIndex)
+{
+	GenericScopedLock lock(referenceLock);
+	if (isPositiveAndBelow(multiplexIndex, referenceCache.size())) referenceCache.getReference(multiplexIndex).isValid = false;
+}
+
 var BaseComparator::getJSONData()
 {
 	var data = ControllableContainer::getJSONData();
@@ -75,6 +152,11 @@ void BaseComparator::onContainerParameterChanged(Parameter * p)
 	if (p == compareFunction)
 	{
 		currentFunctionId = compareFunction->getValueData().toString();
+		currentFunction = functionCodes.contains(currentFunctionId.toString()) ? functionCodes[currentFunctionId.toString()] : -1;
+	}
+	else if (p == reference)
+	{
+		invalidateReferenceCache();
 	}
 	ControllableContainer::onContainerParameterChanged(p);
 }
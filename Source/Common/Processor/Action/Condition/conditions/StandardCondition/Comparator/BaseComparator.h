@@ -10,12 +10,14 @@
 
 #pragma once
 
-class ParameterLink;
+#include "Common/ParameterLink/ParameterLink.h"
+
 class BaseComparatorUI;
 
 class BaseComparator :
 	public ControllableContainer,
-	public MultiplexTarget
+	public MultiplexTarget,
+	public ParameterLink::ParameterLinkListener
 {
 public:
 	BaseComparator(Multiplex * multiplex);
@@ -26,12 +28,33 @@ public:
 
 	EnumParameter* compareFunction;
 	Identifier currentFunctionId;
+	int currentFunction; //resolved from currentFunctionId when the option changes, compare() only switches on it
+	HashMap<String, int> functionCodes;
+
+	//Reference value converted once per multiplex index, reset when the reference or its link changes
+	struct CachedReference
+	{
+		bool isValid = false;
+		float values[3] = { 0, 0, 0 }; //number, bool and point components
+		var data; //enum and string references
+	};
+
+	SpinLock referenceLock;
+	Array<CachedReference> referenceCache;
 	
 	void setReferenceParam(Parameter*); //go through this to have automatic link for multiplex
 
-	void addCompareOption(const String& name, const Identifier& func);
+	void addCompareOption(const String& name, const Identifier& func, int function);
 	void updateReferenceRange(Parameter* sourceParam);
 
+	CachedReference getReference(int multiplexIndex);
+	bool canCacheReference();
+	void invalidateReferenceCache();
+
+	void multiplexCountChanged() override;
+	void linkUpdated(ParameterLink* pLink) override;
+	void linkedValueUpdated(ParameterLink* pLink, int multiplexIndex) override;
+
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
 
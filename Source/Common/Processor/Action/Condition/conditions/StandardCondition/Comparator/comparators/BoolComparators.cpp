@@ -14,8 +14,8 @@ BoolComparator::BoolComparator(Parameter * sourceParam, Multiplex* multiplex) :
 	setReferenceParam(new BoolParameter("Reference", "Comparison Reference to check against source value", sourceParam->boolValue()));
 	reference->setValue(sourceParam->boolValue(), false, true, true);
 
-	addCompareOption("=", equalsId);
-	addCompareOption("!=", differentId);
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("!=", differentId, DIFFERENT);
 }
 
 BoolComparator::~BoolComparator()
@@ -24,8 +24,12 @@ BoolComparator::~BoolComparator()
 
 bool BoolComparator::compare(Parameter * sourceParam, int multiplexIndex)
 {
-	bool value = isMultiplexed() ? (bool)refLink->getLinkedValue(multiplexIndex) : reference->boolValue();
-	if (currentFunctionId == equalsId) return sourceParam->boolValue() == value;
-	else if (currentFunctionId == differentId) return sourceParam->boolValue() != reference->boolValue();
+	bool value = getReference(multiplexIndex).values[0] != 0;
+
+	switch (currentFunction)
+	{
+	case EQUALS:	return sourceParam->boolValue() == value;
+	case DIFFERENT:	return sourceParam->boolValue() != value;
+	}
 	return false;
 }
\ No newline at end of file
@@ -20,5 +20,7 @@ public:
 	const Identifier equalsId = "=";
 	const Identifier differentId = "!=";
 
+	enum Function { EQUALS, DIFFERENT };
+
 	virtual bool compare(Parameter* sourceParam, int multiplexIndex = 0) override;
 };
\ No newline at end of file
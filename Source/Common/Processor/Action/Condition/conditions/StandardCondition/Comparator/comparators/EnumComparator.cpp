@@ -18,8 +18,8 @@ EnumComparator::EnumComparator(Parameter * sourceParam, Multiplex* multiplex) :
 
 	for (auto &ev : ep->enumValues) enumRef->addOption(ev->key, ev->value);
 
-	addCompareOption("=", equalsId);
-	addCompareOption("!=", differentId);
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("!=", differentId, DIFFERENT);
 
 	enumRef->setValue(ep->value, false, true, true);
 }
@@ -30,8 +30,12 @@ EnumComparator::~EnumComparator()
 
 bool EnumComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : enumRef->getValueData();
-	if (currentFunctionId == equalsId) return ((EnumParameter*)sourceParam)->getValueData() == value;
-	if (currentFunctionId == differentId) return ((EnumParameter *)sourceParam)->getValueData() != value;
+	var value = isMultiplexed() ? getReference(multiplexIndex).data : enumRef->getValueData();
+
+	switch (currentFunction)
+	{
+	case EQUALS:	return ((EnumParameter*)sourceParam)->getValueData() == value;
+	case DIFFERENT:	return ((EnumParameter*)sourceParam)->getValueData() != value;
+	}
 	return false;
 }
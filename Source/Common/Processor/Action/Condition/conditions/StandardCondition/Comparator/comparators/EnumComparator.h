@@ -20,6 +20,8 @@ public:
 	const Identifier equalsId = "=";
 	const Identifier differentId = "!=";
 
+	enum Function { EQUALS, DIFFERENT };
+
 	EnumParameter * enumRef;
 
 	virtual bool compare(Parameter* sourceParam, int multiplexIndex = 0) override;
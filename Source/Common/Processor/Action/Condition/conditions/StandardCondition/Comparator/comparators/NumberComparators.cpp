@@ -23,13 +23,13 @@ NumberComparator::NumberComparator(Parameter * sourceParam, Multiplex* multiplex
 	
 	reference->setValue(sourceParam->floatValue(), false, true, true);
 
-	addCompareOption("=", equalsId);
-	addCompareOption("!=", differentId);
-	addCompareOption(">", greaterId);
-	addCompareOption("<", lessId);
-	addCompareOption(">=", greaterOrEqualId);
-	addCompareOption("<=", lessOrEqualId);
-	//addCompareOption("~", inRangeId);
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("!=", differentId, DIFFERENT);
+	addCompareOption(">", greaterId, GREATER);
+	addCompareOption("<", lessId, LESS);
+	addCompareOption(">=", greaterOrEqualId, GREATER_OR_EQUAL);
+	addCompareOption("<=", lessOrEqualId, LESS_OR_EQUAL);
+	//addCompareOption("~", inRangeId, IN_RANGE);
 }
 
 NumberComparator::~NumberComparator()
@@ -38,15 +38,19 @@ NumberComparator::~NumberComparator()
 
 bool NumberComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
-	float value = isMultiplexed() ? (float)refLink->getLinkedValue(multiplexIndex) : reference->floatValue();
+	float value = getReference(multiplexIndex).values[0];
+	float source = sourceParam->floatValue();
 
-	if (currentFunctionId == equalsId)				return sourceParam->floatValue() == value;
-	else if (currentFunctionId == differentId)		return sourceParam->floatValue() != value;
-	else if (currentFunctionId == greaterId)		return sourceParam->floatValue() > value;
-	else if (currentFunctionId == lessId)			return sourceParam->floatValue() < value;
-	else if (currentFunctionId == greaterOrEqualId)	return sourceParam->floatValue() >= value;
-	else if (currentFunctionId == lessOrEqualId)	return sourceParam->floatValue() <= value;
-	else if (currentFunctionId == inRangeId)		return false; //not implemented, need RangeParameter
+	switch (currentFunction)
+	{
+	case EQUALS:			return source == value;
+	case DIFFERENT:			return source != value;
+	case GREATER:			return source > value;
+	case LESS:				return source < value;
+	case GREATER_OR_EQUAL:	return source >= value;
+	case LESS_OR_EQUAL:		return source <= value;
+	case IN_RANGE:			return false; //not implemented, need RangeParameter
+	}
 	return false;
 }
 
@@ -25,6 +25,8 @@ public:
 	const Identifier lessOrEqualId = "<=";
 	const Identifier inRangeId = "range";
 
+	enum Function { EQUALS, DIFFERENT, GREATER, LESS, GREATER_OR_EQUAL, LESS_OR_EQUAL, IN_RANGE };
+
 	Parameter * refParam;
 
 	virtual bool compare(Parameter* sourceParam, int multiplexIndex = 0) override;
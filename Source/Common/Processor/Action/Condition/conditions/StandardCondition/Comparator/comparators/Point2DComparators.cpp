@@ -12,13 +12,13 @@ Point2DComparator::Point2DComparator(Parameter* sourceParam, Multiplex* multiple
 	BaseComparator(multiplex),
 	sourceParam(sourceParam)
 {
-	addCompareOption("=", equalsId);
-	addCompareOption("Magnitude >", magnGreaterId);
-	addCompareOption("Magnitude <", magnLessId);
-	addCompareOption("X >", xGreaterId);
-	addCompareOption("X <", xLessId);
-	addCompareOption("Y >", yGreaterId);
-	addCompareOption("Y <", yLessId);;
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("Magnitude >", magnGreaterId, MAGN_GREATER);
+	addCompareOption("Magnitude <", magnLessId, MAGN_LESS);
+	addCompareOption("X >", xGreaterId, X_GREATER);
+	addCompareOption("X <", xLessId, X_LESS);
+	addCompareOption("Y >", yGreaterId, Y_GREATER);
+	addCompareOption("Y <", yLessId, Y_LESS);
 
 	updateReferenceParam();
 }
@@ -79,14 +79,17 @@ void Point2DComparator::updateReferenceParam()
 bool Point2DComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
 	Point<float> p = ((Point2DParameter*)sourceParam)->getPoint();
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
+	CachedReference r = getReference(multiplexIndex);
 
-	if (currentFunctionId == equalsId)				return p == Point<float>(value[0], value[1]);
-	else if (currentFunctionId == magnGreaterId)	return p.getDistanceFromOrigin() > (float)value;
-	else if (currentFunctionId == magnLessId)		return p.getDistanceFromOrigin() < (float)value;
-	else if (currentFunctionId == xGreaterId)	return p.x > (float)value;
-	else if (currentFunctionId == xLessId)		return p.x < (float)value; 
-	else if (currentFunctionId == yGreaterId)	return p.y > (float)value;
-	else if (currentFunctionId == yLessId)		return p.y < (float)value; 
+	switch (currentFunction)
+	{
+	case EQUALS:		return p == Point<float>(r.values[0], r.values[1]);
+	case MAGN_GREATER:	return p.getDistanceFromOrigin() > r.values[0];
+	case MAGN_LESS:		return p.getDistanceFromOrigin() < r.values[0];
+	case X_GREATER:		return p.x > r.values[0];
+	case X_LESS:		return p.x < r.values[0];
+	case Y_GREATER:		return p.y > r.values[0];
+	case Y_LESS:		return p.y < r.values[0];
+	}
 	return false;
 }
\ No newline at end of file
@@ -25,6 +25,8 @@ public:
 	const Identifier yGreaterId = "y>";
 	const Identifier yLessId = "y<";
 
+	enum Function { EQUALS, MAGN_GREATER, MAGN_LESS, X_GREATER, X_LESS, Y_GREATER, Y_LESS };
+
 	Parameter* sourceParam;
 
 	void onContainerParameterChanged(Parameter* p) override;
@@ -14,15 +14,15 @@ Point3DComparator::Point3DComparator(Parameter* sourceParam, Multiplex* multiple
 {
 
 
-	addCompareOption("=", equalsId);
-	addCompareOption("Magnitude >", magnGreaterId);
-	addCompareOption("Magnitude <", magnLessId);
-	addCompareOption("X >", xGreaterId);
-	addCompareOption("X <", xLessId);
-	addCompareOption("Y >", yGreaterId);
-	addCompareOption("Y <", yLessId);
-	addCompareOption("Z >", zGreaterId);
-	addCompareOption("Z <", zLessId);
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("Magnitude >", magnGreaterId, MAGN_GREATER);
+	addCompareOption("Magnitude <", magnLessId, MAGN_LESS);
+	addCompareOption("X >", xGreaterId, X_GREATER);
+	addCompareOption("X <", xLessId, X_LESS);
+	addCompareOption("Y >", yGreaterId, Y_GREATER);
+	addCompareOption("Y <", yLessId, Y_LESS);
+	addCompareOption("Z >", zGreaterId, Z_GREATER);
+	addCompareOption("Z <", zLessId, Z_LESS);
 	updateReferenceParam();
 }
 
@@ -84,17 +84,19 @@ bool Point3DComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
 
 	Vector3D<float> p = ((Point3DParameter*)sourceParam)->getVector();
-	var value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex) : reference->getValue();
-
-	if (currentFunctionId == equalsId)				return p.x == (float)value[0] && p.y == (float)value[1] && p.z == (float)value[2];
-	else if (currentFunctionId == magnGreaterId)	return p.length() > (float)value;
-	else if (currentFunctionId == magnLessId)		return p.length() < (float)value;
-	else if (currentFunctionId == xGreaterId)	return p.x > (float)value;
-	else if (currentFunctionId == xLessId)		return p.x < (float)value;
-	else if (currentFunctionId == yGreaterId)	return p.y > (float)value;
-	else if (currentFunctionId == yLessId)		return p.y < (float)value;
-	else if (currentFunctionId == zGreaterId)	return p.z > (float)value;
-	else if (currentFunctionId == zLessId)		return p.z < (float)value; 
-	
+	CachedReference r = getReference(multiplexIndex);
+
+	switch (currentFunction)
+	{
+	case EQUALS:		return p.x == r.values[0] && p.y == r.values[1] && p.z == r.values[2];
+	case MAGN_GREATER:	return p.length() > r.values[0];
+	case MAGN_LESS:		return p.length() < r.values[0];
+	case X_GREATER:		return p.x > r.values[0];
+	case X_LESS:		return p.x < r.values[0];
+	case Y_GREATER:		return p.y > r.values[0];
+	case Y_LESS:		return p.y < r.values[0];
+	case Z_GREATER:		return p.z > r.values[0];
+	case Z_LESS:		return p.z < r.values[0];
+	}
 	return false;
 }
@@ -26,6 +26,9 @@ public:
 	const Identifier yLessId = "y<";
 	const Identifier zGreaterId = "z>";
 	const Identifier zLessId = "z<";
+
+	enum Function { EQUALS, MAGN_GREATER, MAGN_LESS, X_GREATER, X_LESS, Y_GREATER, Y_LESS, Z_GREATER, Z_LESS };
+
 	Parameter* sourceParam;
 
 	void onContainerParameterChanged(Parameter* p) override;
@@ -14,11 +14,11 @@ StringComparator::StringComparator(Parameter *sourceParam, Multiplex* multiplex)
 	setReferenceParam(new StringParameter("Reference", "Comparison Reference to check against source value", sourceParam->stringValue()));
 	reference->setValue(sourceParam->stringValue(), false, true, true);
 
-	addCompareOption("=", equalsId);
-	addCompareOption("!=", differentId);
-	addCompareOption("Contains", containsId);
-	addCompareOption("Starts with", startsWith);
-	addCompareOption("Ends with", endsWidth);
+	addCompareOption("=", equalsId, EQUALS);
+	addCompareOption("!=", differentId, DIFFERENT);
+	addCompareOption("Contains", containsId, CONTAINS);
+	addCompareOption("Starts with", startsWith, STARTS_WITH);
+	addCompareOption("Ends with", endsWidth, ENDS_WITH);
 }
 
 StringComparator::~StringComparator()
@@ -27,12 +27,16 @@ StringComparator::~StringComparator()
 
 bool StringComparator::compare(Parameter* sourceParam, int multiplexIndex)
 {
-	String value = isMultiplexed() ? refLink->getLinkedValue(multiplexIndex).toString() : reference->stringValue();
+	String value = isMultiplexed() ? getReference(multiplexIndex).data.toString() : reference->stringValue();
+	String source = sourceParam->stringValue();
 
-	if (currentFunctionId == equalsId)				return sourceParam->stringValue() == value;
-	else if (currentFunctionId == differentId)		return sourceParam->stringValue() != value;
-	else if (currentFunctionId == containsId)		return sourceParam->stringValue().contains(value);
-	else if (currentFunctionId == startsWith)		return sourceParam->stringValue().startsWith(value);
-	else if (currentFunctionId == endsWidth)		return sourceParam->stringValue().endsWith(value);
+	switch (currentFunction)
+	{
+	case EQUALS:		return source == value;
+	case DIFFERENT:		return source != value;
+	case CONTAINS:		return source.contains(value);
+	case STARTS_WITH:	return source.startsWith(value);
+	case ENDS_WITH:		return source.endsWith(value);
+	}
 	return false;
 }
\ No newline at end of file
@@ -23,5 +23,7 @@ public:
 	const Identifier startsWith = "startsWith";
 	const Identifier endsWidth = "endsWidth";
 
+	enum Function { EQUALS, DIFFERENT, CONTAINS, STARTS_WITH, ENDS_WITH };
+
 	virtual bool compare(Parameter* sourceParam, int multiplexIndex) override;
 };
\ No newline at end of file
@@ -52,8 +52,7 @@ void StandardCondition::clearItem()
 	if (sourceList != nullptr) sourceList->removeListListener(this);
 	if (sourceControllable != nullptr)
 	{
-		if (sourceControllable->type == Controllable::TRIGGER) ((Trigger*)sourceControllable.get())->removeTriggerListener(this);
-		else ((Parameter *)sourceControllable.get())->removeParameterListener(this);
+		if (ConditionSourceIndex* index = ConditionSourceIndex::getInstanceWithoutCreating()) index->unregisterCondition(this, sourceControllable.get());
 	}
 }
 
@@ -98,19 +97,12 @@ void StandardCondition::updateSourceFromTarget()
 	}
 	else
 	{
-		if (sourceControllable != nullptr)
-		{
-			if (sourceControllable->type == Controllable::TRIGGER) ((Trigger*)sourceControllable.get())->removeTriggerListener(this);
-			else ((Parameter*)sourceControllable.get())->removeParameterListener(this);
-		}
+		//the source is listened to by the index, shared by all the conditions using it
+		if (sourceControllable != nullptr) ConditionSourceIndex::getInstance()->unregisterCondition(this, sourceControllable.get());
 
 		sourceControllable = sourceTarget->target;
 
-		if (sourceControllable != nullptr)
-		{
-			if (sourceControllable->type == Controllable::TRIGGER) ((Trigger*)sourceControllable.get())->addTriggerListener(this);
-			else ((Parameter*)sourceControllable.get())->addParameterListener(this);
-		}
+		if (sourceControllable != nullptr) ConditionSourceIndex::getInstance()->registerCondition(this, sourceControllable.get());
 	}
 
 	updateComparatorFromSource();
@@ -198,6 +190,12 @@ void StandardCondition::forceCheck()
 	for (int i = 0; i < getMultiplexCount(); i++) checkComparator(i);
 }
 
+void StandardCondition::sourceUpdated()
+{
+	if (multiplexListMode) return;
+	for (int i = 0; i < getMultiplexCount(); i++) checkComparator(i);
+}
+
 void StandardCondition::forceToggleState(bool value)
 {
 	rawIsValids.fill(value);
@@ -240,10 +238,7 @@ void StandardCondition::onControllableFeedbackUpdateInternal(ControllableContain
 
 void StandardCondition::onExternalParameterValueChanged(Parameter* p)
 {
-	if (!multiplexListMode)
-	{
-		for (int i = 0; i < getMultiplexCount(); i++) checkComparator(i);
-	}
+	if (p == sourceControllable) sourceUpdated();
 }
 
 void StandardCondition::onExternalParameterRangeChanged(Parameter* p)
@@ -253,11 +248,7 @@ void StandardCondition::onExternalParameterRangeChanged(Parameter* p)
 
 void StandardCondition::onExternalTriggerTriggered(Trigger* t)
 {
-	if (!multiplexListMode)
-	{
-		for (int i = 0; i < getMultiplexCount(); i++) checkComparator(i);
-
-	}
+	if (t == sourceControllable) sourceUpdated();
 }
 
 var StandardCondition::getJSONData()
@@ -55,6 +55,9 @@ public:
 
 	void forceCheck() override;
 
+	//Called by the ConditionSourceIndex when the source value changed or was triggered
+	void sourceUpdated();
+
 	void onContainerParameterChangedInternal(Parameter * p) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
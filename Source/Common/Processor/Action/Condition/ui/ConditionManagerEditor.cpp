@@ -18,6 +18,7 @@ ConditionManagerEditor::ConditionManagerEditor(ConditionManager * _manager, bool
 	if (isSequential) updateSequentialUI();
 
 	conditionManager->addAsyncConditionManagerListener(this);
+	startTimerHz(20);
 	repaint();
 }
 
@@ -27,6 +28,13 @@ ConditionManagerEditor::~ConditionManagerEditor()
 }
 
 
+void ConditionManagerEditor::timerCallback()
+{
+	//validation progress is only computed while it is shown
+	if (inspectable.wasObjectDeleted() || !isShowing() || conditionManager->validationTime->floatValue() == 0) return;
+	conditionManager->updateValidationProgressFeedback();
+}
+
 void ConditionManagerEditor::updateSequentialUI()
 {
 	bool isSequential = conditionManager->conditionOperator->getValueDataAsEnum<ConditionManager::ConditionOperator>() == ConditionManager::SEQUENTIAL;
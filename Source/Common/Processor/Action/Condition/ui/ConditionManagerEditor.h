@@ -12,7 +12,8 @@
 
 class ConditionManagerEditor :
 	public GenericManagerEditor<Condition>,
-	public ConditionManager::AsyncListener
+	public ConditionManager::AsyncListener,
+	public Timer
 {
 public:
 	ConditionManagerEditor(ConditionManager *_manager, bool isRoot);
@@ -29,4 +30,6 @@ public:
 
 	void newMessage(const ConditionManager::ConditionManagerEvent& e) override;
 
+	void timerCallback() override;
+
 };
\ No newline at end of file
@@ -25,4 +25,10 @@ void Consequence::triggerCommand(int multiplexIndex)
 {
 	if (!enabled->boolValue() || forceDisabled) return;
 	BaseCommandHandler::triggerCommand(multiplexIndex);
+}
+
+bool Consequence::canScheduleOutput()
+{
+	if (!enabled->boolValue() || forceDisabled) return true; //nothing will be sent
+	return command != nullptr && command->module != nullptr && command->module->canScheduleOutput();
 }
\ No newline at end of file
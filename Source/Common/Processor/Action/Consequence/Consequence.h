@@ -22,6 +22,7 @@ public:
 	bool forceDisabled;
 	
 	virtual void triggerCommand(int multiplexIndex = 0) override;
+	bool canScheduleOutput();
 
 	class ConsequenceListener
 	{
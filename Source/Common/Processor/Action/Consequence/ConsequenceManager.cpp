@@ -13,7 +13,8 @@
 ConsequenceManager::ConsequenceManager(const String& name, Multiplex* multiplex) :
     BaseManager<Consequence>(name),
     MultiplexTarget(multiplex),
-	forceDisabled(false)
+	forceDisabled(false),
+	scheduleGeneration(0)
 {
 	canBeDisabled = false;
 	canBeCopiedAndPasted = true;
@@ -27,11 +28,13 @@ ConsequenceManager::ConsequenceManager(const String& name, Multiplex* multiplex)
 	stagger = addFloatParameter("Stagger", "If multiple consequences are there, delay between each consequence trigger", 0, 0);
 	stagger->defaultUI = FloatParameter::TIME;
 	stagger->hideInEditor = true;
+	propagateOnce = addBoolParameter("Propagate Once", "If checked and consequences are triggered without delay nor stagger, mappings and conditions depending on the values they change are processed once after all of them with the final values, instead of after each one. Useful for scenes recalling many presets", false);
+	propagateOnce->hideInEditor = true;
 }
 
 ConsequenceManager::~ConsequenceManager()
 {
-	
+	cancelScheduledTriggers();
 }
 
 Consequence* ConsequenceManager::createItem()
@@ -45,6 +48,8 @@ void ConsequenceManager::triggerAll(int multiplexIndex)
 	{
 		if (delay->floatValue() == 0 && stagger->floatValue() == 0)
 		{
+			//opt-in, downstream work then runs after all the consequences instead of in between
+			std::unique_ptr<PropagationBatch> batch(propagateOnce->boolValue() ? new PropagationBatch() : nullptr);
 			for (auto& c : items)
 			{
 				c->triggerCommand(multiplexIndex);
@@ -52,11 +57,38 @@ void ConsequenceManager::triggerAll(int multiplexIndex)
 		}
 		else
 		{
-			staggerLaunchers.add(new StaggerLauncher(this, multiplexIndex));
+			double startTime = Time::getMillisecondCounterHiRes() + delay->floatValue() * 1000;
+			double s = stagger->floatValue() * 1000;
+
+			EventScheduler* scheduler = EventScheduler::getInstance();
+			int generation = scheduleGeneration;
+			for (int i = 0; i < items.size(); ++i)
+			{
+				Consequence* c = items[i];
+				WeakReference<Inspectable> cRef(c);
+				scheduler->scheduleAt(startTime + s * i, [this, c, cRef, multiplexIndex, generation]()
+				{
+					MessageManager::callAsync([this, c, cRef, multiplexIndex, generation]()
+					{
+						//the manager outlives its consequences
+						if (cRef.wasObjectDeleted() || generation != scheduleGeneration) return;
+						c->triggerCommand(multiplexIndex);
+					});
+				}, c);
+			}
 		}
 	}
 }
 
+bool ConsequenceManager::canScheduleOutputs()
+{
+	//delayed and staggered consequences are scheduled from the moment they are triggered
+	if (delay->floatValue() > 0 || stagger->floatValue() > 0) return false;
+
+	for (auto& c : items) if (!c->canScheduleOutput()) return false;
+	return true;
+}
+
 void ConsequenceManager::setForceDisabled(bool value, bool force)
 {
 	if (forceDisabled == value && !force) return;
@@ -77,61 +109,29 @@ void ConsequenceManager::addItemInternal(Consequence* c, var data)
 	//triggerAll->hideInEditor = items.size() == 0;
 	delay->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
+	propagateOnce->hideInEditor = items.size() < 2;
 }
 
-void ConsequenceManager::removeItemInternal(Consequence*)
+void ConsequenceManager::removeItemInternal(Consequence* c)
 {
+	if (EventScheduler* scheduler = EventScheduler::getInstanceWithoutCreating()) scheduler->cancelAll(c);
+
 	//triggerAll->hideInEditor = items.size() == 0;
 	delay->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
+	propagateOnce->hideInEditor = items.size() < 2;
 }
 
-void ConsequenceManager::launcherFinished(StaggerLauncher* launcher)
+void ConsequenceManager::cancelScheduledTriggers()
 {
-	staggerLaunchers.removeObject(launcher);
+	scheduleGeneration++;
+
+	EventScheduler* scheduler = EventScheduler::getInstanceWithoutCreating();
+	if (scheduler == nullptr) return;
+	for (auto& c : items) scheduler->cancelAll(c);
 }
 
 InspectableEditor* ConsequenceManager::getEditor(bool isRoot)
 {
 	return new BaseCommandHandlerManagerEditor<Consequence>(this, CommandContext::ACTION, isRoot, isMultiplexed());
 }
-
-ConsequenceManager::StaggerLauncher::StaggerLauncher(ConsequenceManager* csm, int multiplexIndex) :
-	Thread("Stagger Launcher"),
-	csm(csm),
-	multiplexIndex(multiplexIndex)
-{
-	startThread();
-}
-
-ConsequenceManager::StaggerLauncher::~StaggerLauncher()
-{
-	stopThread(100);
-}
-
-void ConsequenceManager::StaggerLauncher::run()
-{
-	timeAtRun = Time::getMillisecondCounter();
-	triggerIndex = 0;
-
-	uint32 d = (uint32)(csm->delay->floatValue() * 1000);
-	uint32 s = (uint32)(csm->stagger->floatValue() * 1000);
-
-	uint32 curTime = timeAtRun;
-
-	while (triggerIndex < csm->items.size())
-	{
-		uint32 nextTriggerTime = timeAtRun + d + s * triggerIndex;
-		while (nextTriggerTime > curTime)
-		{
-			if (threadShouldExit()) return;
-			wait(jmin<uint32>(nextTriggerTime - curTime, 20));
-			curTime = Time::getMillisecondCounter();
-			nextTriggerTime = timeAtRun + d + s * triggerIndex;
-		}
-
-		if (triggerIndex >= csm->items.size()) return;
-		csm->items[triggerIndex]->triggerCommand(multiplexIndex);
-		triggerIndex++;
-	}
-}
@@ -21,6 +21,7 @@ public:
 	
 	FloatParameter * delay;
 	FloatParameter * stagger;
+	BoolParameter * propagateOnce;
 
 	bool forceDisabled;
 
@@ -28,31 +29,19 @@ public:
 
 	void triggerAll(int multiplexIndex = 0);
 
+	//True if all the consequences send their outputs at the current EventTimestamp, so they can be triggered ahead of time
+	bool canScheduleOutputs();
+
 	void setForceDisabled(bool value, bool force = false);
 
 	void onContainerTriggerTriggered(Trigger *) override;
 	void addItemInternal(Consequence *, var data) override;
 	void removeItemInternal(Consequence *) override;
 
-
-	class StaggerLauncher :
-		public Thread
-	{
-	public:
-		StaggerLauncher(ConsequenceManager * csm, int multiplexIndex);
-		~StaggerLauncher();
-
-		ConsequenceManager* csm;
-		int multiplexIndex;
-
-		uint32 timeAtRun;
-		int triggerIndex;
-
-		void run() override;
-	};
-	OwnedArray<StaggerLauncher> staggerLaunchers;
-
-	void launcherFinished(StaggerLauncher * launcher);
+	//Delayed and staggered triggers are timed on the EventScheduler, with the consequence as owner, and triggered on the message thread :
+	//commands may wait for the message thread, which itself waits for running scheduler tasks when cancelling
+	std::atomic<int> scheduleGeneration; //triggers already posted when cancelled are dropped
+	void cancelScheduledTriggers();
 
 	InspectableEditor * getEditor(bool isRoot) override; 
 
@@ -35,6 +35,7 @@ ActionUI::ActionUI(Action* _action) :
 		progressionUI->showValue = false;
 		addChildComponent(progressionUI.get());
 		progressionUI->setVisible(action->cdm.validationTime->floatValue() > 0);
+		if (progressionUI->isVisible()) startTimerHz(20);
 	}
 
 	updateBGColor();
@@ -80,9 +81,19 @@ void ActionUI::controllableFeedbackUpdateInternal(Controllable* c)
 			progressionUI->setVisible(v);
 			resized();
 		}
+
+		if (v) startTimerHz(20);
+		else stopTimer();
 	}
 }
 
+void ActionUI::timerCallback()
+{
+	//validation progress is only computed while it is shown
+	if (inspectable.wasObjectDeleted() || !isShowing()) return;
+	action->cdm.updateValidationProgressFeedback();
+}
+
 void ActionUI::resizedInternalHeader(Rectangle<int>& r)
 {
 	BaseItemUI::resizedInternalHeader(r);
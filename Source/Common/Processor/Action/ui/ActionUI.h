@@ -12,7 +12,8 @@
 
 class ActionUI :
 	public ProcessorUI,
-	public Action::AsyncListener
+	public Action::AsyncListener,
+	public Timer
 {
 public:
 	ActionUI(Action *);
@@ -36,6 +37,8 @@ public:
 
 	void newMessage(const Action::ActionEvent &e) override;
 
+	void timerCallback() override;
+
 	virtual void addContextMenuItems(PopupMenu& p) override;
 	virtual void handleContextMenuResult(int result) override;
 
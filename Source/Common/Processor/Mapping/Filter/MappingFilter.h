@@ -45,6 +45,9 @@ public:
 	virtual ProcessResult processInternal(Array<Parameter*> inputs, int multiplexIndex);
 	virtual ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) { return UNCHANGED; }
 
+	//Offline rendering : time based filters advance by this fixed time at each process instead of the real elapsed time, 0 to use the real time
+	virtual void setFixedDeltaTime(double /*deltaTime*/) {}
+
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer *, Controllable * p) override;
 	virtual void filterParamChanged(Parameter * ) {};
@@ -9,7 +9,8 @@
 */
 
 TimeFilter::TimeFilter(StringRef name, var params, Multiplex* multiplex) :
-    MappingFilter(name, params, multiplex)
+    MappingFilter(name, params, multiplex),
+    fixedDeltaTime(0)
 {
     deltaTimes.resize(getMultiplexCount());
     for (int i = 0; i < timesAtLastUpdate.size(); i++) timesAtLastUpdate.set(i, Time::getMillisecondCounter() / 1000.0);
@@ -31,10 +32,16 @@ void TimeFilter::multiplexCountChanged()
     deltaTimes.fill(0);
 }
 
+void TimeFilter::setFixedDeltaTime(double deltaTime)
+{
+    fixedDeltaTime = deltaTime;
+}
+
 MappingFilter::ProcessResult TimeFilter::processInternal(Array<Parameter*> sources, int multiplexIndex)
 {
     double curTime = Time::getMillisecondCounter() / 1000.0;
-    deltaTimes.set(multiplexIndex, jmax<double>(curTime - timesAtLastUpdate.getUnchecked(multiplexIndex), 0));
+    if (fixedDeltaTime > 0) deltaTimes.set(multiplexIndex, fixedDeltaTime);
+    else deltaTimes.set(multiplexIndex, jmax<double>(curTime - timesAtLastUpdate.getUnchecked(multiplexIndex), 0));
 
     ProcessResult r = MappingFilter::processInternal(sources, multiplexIndex);
 
@@ -19,8 +19,10 @@ public:
 
 	Array<double> timesAtLastUpdate; //multiplexed
 	Array<double> deltaTimes; //multiplexed
+	double fixedDeltaTime;
 
 	virtual void multiplexCountChanged() override;
+	void setFixedDeltaTime(double deltaTime) override;
 
 	ProcessResult processInternal(Array<Parameter*> sources, int multiplexIndex) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
@@ -9,7 +9,9 @@
 */
 
 LagFilter::LagFilter(var params, Multiplex* multiplex) :
-	MappingFilter(getTypeString(), params, multiplex)
+	MappingFilter(getTypeString(), params, multiplex),
+	fixedDeltaTime(0),
+	timeSinceLastSample(0)
 {
 	frequency = filterParams.addFloatParameter("Frequency", "Lag frequency in Hz", 5, .01f, 50);
 	startTimer(1000 / frequency->floatValue());
@@ -22,6 +24,14 @@ LagFilter::~LagFilter()
 
 }
 
+void LagFilter::setFixedDeltaTime(double deltaTime)
+{
+	fixedDeltaTime = deltaTime;
+	timeSinceLastSample = 0;
+	if (fixedDeltaTime > 0) stopTimer();
+	else startTimer(1000 / frequency->floatValue());
+}
+
 void LagFilter::setupParametersInternal(int multiplexIndex, bool rangeOnly)
 {
 	if(!rangeOnly) paramTempValueMap.clear();
@@ -38,6 +48,22 @@ Parameter* LagFilter::setupSingleParameterInternal(Parameter* source, int multip
 	return MappingFilter::setupSingleParameterInternal(source, multiplexIndex, rangeOnly);
 }
 
+MappingFilter::ProcessResult LagFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+{
+	if (fixedDeltaTime > 0)
+	{
+		timeSinceLastSample += fixedDeltaTime;
+		double period = 1.0 / frequency->floatValue();
+		if (timeSinceLastSample >= period)
+		{
+			timeSinceLastSample = fmod(timeSinceLastSample, period);
+			hiResTimerCallback();
+		}
+	}
+
+	return MappingFilter::processInternal(inputs, multiplexIndex);
+}
+
 MappingFilter::ProcessResult  LagFilter::processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex)
 {
 	if (!paramTempValueMap.contains(source)) return UNCHANGED;
@@ -49,7 +75,7 @@ MappingFilter::ProcessResult  LagFilter::processSingleParameterInternal(Paramete
 
 void LagFilter::filterParamChanged(Parameter * p)
 {
-	if(p == frequency) startTimer(1000 / frequency->floatValue());
+	if(p == frequency && fixedDeltaTime <= 0) startTimer(1000 / frequency->floatValue());
 }
 
 void LagFilter::hiResTimerCallback()
@@ -21,8 +21,14 @@ public:
 	HashMap<Parameter*, var> paramTempValueMap;
 	FloatParameter * frequency;
 
+	double fixedDeltaTime; //offline rendering, values are sampled in rendered time instead of by the timer
+	double timeSinceLastSample;
+
+	void setFixedDeltaTime(double deltaTime) override;
+
 	void setupParametersInternal(int multiplexIndex, bool rangeOnly) override;
 	Parameter* setupSingleParameterInternal(Parameter* source, int multiplexIndex, bool rangeOnly) override;
+	ProcessResult processInternal(Array<Parameter*> inputs, int multiplexIndex) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
 	void filterParamChanged(Parameter * p) override;
@@ -11,7 +11,6 @@
 Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 	Processor("Mapping", canBeDisabled),
 	MultiplexTarget(multiplex),
-	Thread("Mapping"),
 	im(multiplex),
 	mappingParams("Parameters"),
 	fm(multiplex),
@@ -22,6 +21,11 @@ Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 	isProcessing(false),
 	shouldRebuildAfterProcess(false),
 	inputIsLocked(false),
+	isContinuousProcessing(false),
+	continuousGeneration(0),
+	continuousLiveness(new EventScheduler::OwnerLiveness()),
+	nextContinuousProcessTime(0),
+	slowProcessWarned(false),
 	mappingNotifier(10)
 {
 	itemDataType = "Mapping";
@@ -54,7 +58,6 @@ Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 
 Mapping::~Mapping()
 {
-	stopThread(100);
 	clearItem();
 }
 
@@ -246,15 +249,66 @@ void Mapping::process(bool forceOutput, int multiplexIndex)
 
 void Mapping::updateContinuousProcess()
 {
-	if ((!canBeDisabled || enabled->boolValue()) && !forceDisabled)
+	setContinuousProcessing((!canBeDisabled || enabled->boolValue()) && !forceDisabled && updateRate->enabled && !isClearing);
+}
+
+void Mapping::setContinuousProcessing(bool value)
+{
+	if (isContinuousProcessing == value) return;
+	isContinuousProcessing = value;
+
+	//parking and unparking never wait, a process already running just won't schedule the next one
+	if (value)
+	{
+		int generation = ++continuousGeneration;
+		if (!continuousLiveness->isAlive) continuousLiveness = new EventScheduler::OwnerLiveness(); //unparked again after a clear
+		nextContinuousProcessTime = Time::getMillisecondCounterHiRes() + 50; //make sure direct calls have been done before (especially if it was loading)
+		scheduleContinuousProcess(generation, continuousLiveness);
+	}
+	else if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating())
+	{
+		scheduler->cancelAll(this, false);
+	}
+}
+
+void Mapping::stopContinuousProcess()
+{
+	isContinuousProcessing = false;
+	continuousLiveness->isAlive = false;
+	if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating())
 	{
-		if (updateRate->enabled) startThread();
-		//for (int i = 0; i < getMultiplexCount(); i++) process(false, i);
+		//a running process uses the inputs and filters, but its outputs may wait for the message thread, so the wait is bounded like the thread it replaced
+		scheduler->cancelAll(this, true, 100);
+		scheduler->cancelAll(this, false); //a process that was running when parking may have scheduled the next one
 	}
-	else
+}
+
+void Mapping::scheduleContinuousProcess(int generation, EventScheduler::OwnerLiveness::Ptr liveness)
+{
+	ContinuousProcessScheduler::getInstance()->scheduleAt(nextContinuousProcessTime, [this, generation, liveness]()
+		{
+			if (liveness->isAlive) processContinuous(generation, liveness);
+		}, this);
+}
+
+void Mapping::processContinuous(int generation, EventScheduler::OwnerLiveness::Ptr liveness)
+{
+	if (!isContinuousProcessing || generation != continuousGeneration) return;
+
+	double startTime = Time::getMillisecondCounterHiRes();
+	for (int i = 0; i < getMultiplexCount() && liveness->isAlive; i++) process(false, i);
+	if (!liveness->isAlive) return; //stopped while processing, the mapping may be gone
+
+	//next time is based on the previous one so the rate doesn't drift, but late processes are not piled up
+	double rateMillis = 1000.0 / jmax(1, updateRate->intValue());
+	if (!slowProcessWarned && Time::getMillisecondCounterHiRes() - startTime > rateMillis)
 	{
-		stopThread(1000);
+		slowProcessWarned = true;
+		NLOGWARNING(niceName, "Processing takes longer than the update rate, this delays the other continuously processed mappings. Lower the update rate or simplify the filters.");
 	}
+
+	nextContinuousProcessTime = jmax(nextContinuousProcessTime + rateMillis, Time::getMillisecondCounterHiRes());
+	scheduleContinuousProcess(generation, liveness);
 }
 
 void Mapping::setForceDisabled(bool value, bool force)
@@ -318,6 +372,9 @@ void Mapping::inputParameterValueChanged(MappingInput*, int multiplexIndex)
 {
 	if (processMode == VALUE_CHANGE)
 	{
+		//in a propagation batch, process once with the final values of all the inputs
+		if (PropagationBatch::defer(this, multiplexIndex, [this, multiplexIndex]() { inputParameterValueChanged(nullptr, multiplexIndex); })) return;
+
 		if (multiplexIndex == -1)
 		{
 			for (int i = 0; i < getMultiplexCount(); i++) process(false, i); //process all if value updated from a non-iterative input
@@ -349,8 +406,7 @@ void Mapping::onControllableStateChanged(Controllable* c)
 	Processor::onControllableStateChanged(c);
 	if (c == updateRate)
 	{
-		if (updateRate->enabled && enabled->boolValue()) startThread();
-		else stopThread(1000);
+		updateContinuousProcess();
 	}
 }
 
@@ -372,41 +428,13 @@ void Mapping::clearItem()
 {
 	Processor::clearItem();
 
+	stopContinuousProcess();
+
 	fm.removeFilterManagerListener(this);
 	im.removeBaseManagerListener(this);
 	im.clear();
 }
 
-void Mapping::run()
-{
-	wait(50); //make sure direct calls have been done before running this (especially if it was loading)
-
-	uint32 millis;
-
-	while (!threadShouldExit())
-	{
-		uint32 rateMillis = 1000 / updateRate->intValue();
-
-		if ((canBeDisabled && !enabled->boolValue()) || forceDisabled)
-		{
-			wait(rateMillis);
-			continue;
-		}
-
-		millis = Time::getMillisecondCounter();
-
-		for (int i = 0; i < getMultiplexCount(); i++) process(false, i);
-
-		uint32 newMillis = Time::getMillisecondCounter();
-
-
-		uint32 millisToWait = rateMillis - jmax<uint32>(newMillis - millis, 0);
-		millis = newMillis;
-
-		if (millisToWait > 0) wait(millisToWait);
-	}
-}
-
 ProcessorUI* Mapping::getUI()
 {
 	return new MappingUI(this);
@@ -15,8 +15,7 @@ class Mapping :
 	public MultiplexTarget,
 	public MappingInput::Listener,
 	public MappingInputManager::ManagerListener,
-	public MappingFilterManager::FilterManagerListener,
-	public Thread
+	public MappingFilterManager::FilterManagerListener
 {
 public:
 	Mapping(var params = var(), Multiplex * multiplex = nullptr, bool canBeDisabled = true);
@@ -52,7 +51,19 @@ public:
 
 	void process(bool forceOutput = false, int multiplexIndex = 0);
 
+	//Continuous processing, the mapping is unparked on the ContinuousProcessScheduler only while it is active
+	//The scheduler thread is shared by all continuous mappings, a warning is logged once if this one takes longer than its update rate
+	std::atomic<bool> isContinuousProcessing;
+	std::atomic<int> continuousGeneration; //a task from a previous unpark stops instead of rescheduling
+	EventScheduler::OwnerLiveness::Ptr continuousLiveness; //passed along the tasks, dead once stopContinuousProcess has been called
+	double nextContinuousProcessTime;
+	bool slowProcessWarned;
+
 	void updateContinuousProcess();
+	void setContinuousProcessing(bool value);
+	void stopContinuousProcess(); //parks and waits a bit for a running process, before clearing or deleting
+	void scheduleContinuousProcess(int generation, EventScheduler::OwnerLiveness::Ptr liveness);
+	void processContinuous(int generation, EventScheduler::OwnerLiveness::Ptr liveness);
 
 	void setForceDisabled(bool value, bool force = false) override;
 
@@ -75,7 +86,6 @@ public:
 	void filterManagerNeedsProcess() override;
 
 	virtual void clearItem() override;
-	virtual void run() override;
 	virtual void highlightLinkedInspectables(bool value) override;
 
 	ProcessorUI* getUI() override;
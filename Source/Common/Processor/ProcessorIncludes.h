@@ -22,6 +22,7 @@
 
 #include "Action/Condition/Condition.h"
 #include "Action/Condition/ConditionManager.h"
+#include "Action/Condition/ConditionSourceIndex.h"
 
 #include "Action/Condition/conditions/ActivationCondition/ActivationCondition.h"
 #include "Action/Condition/conditions/ConditionGroup/ConditionGroup.h"
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    EventScheduler.cpp
+    Created: 18 Oct 2026 9:47:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+juce_ImplementSingleton(EventScheduler)
+juce_ImplementSingleton(ContinuousProcessScheduler)
+
+namespace
+{
+	//std heaps are max-heaps, the earliest task must be at the front
+	bool taskIsLater(const EventScheduler::Task& a, const EventScheduler::Task& b)
+	{
+		return a.time > b.time || (a.time == b.time && a.id > b.id);
+	}
+}
+
+EventScheduler::EventScheduler(const String& name) :
+	Thread(name),
+	idIncrement(0),
+	numCancelled(0),
+	runningOwner(nullptr)
+{
+	startThread(8);
+}
+
+EventScheduler::~EventScheduler()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+}
+
+EventScheduler::TaskID EventScheduler::scheduleAt(double timeMillis, std::function<void()> func, void* owner)
+{
+	if (func == nullptr) return 0;
+
+	TaskID id;
+	bool isFirst;
+	{
+		GenericScopedLock lock(queueLock);
+		id = ++idIncrement;
+		queue.push_back({ timeMillis, id, owner, std::move(func) });
+		std::push_heap(queue.begin(), queue.end(), taskIsLater);
+		isFirst = queue.front().id == id;
+	}
+
+	//only wake up the thread if it has to run earlier than planned
+	if (isFirst) notify();
+	return id;
+}
+
+EventScheduler::TaskID EventScheduler::schedule(double delayMillis, std::function<void()> func, void* owner)
+{
+	return scheduleAt(Time::getMillisecondCounterHiRes() + delayMillis, std::move(func), owner);
+}
+
+void EventScheduler::cancel(TaskID id)
+{
+	GenericScopedLock lock(queueLock);
+	for (auto& t : queue)
+	{
+		if (t.id != id || t.func == nullptr) continue;
+		t.func = nullptr;
+		numCancelled++;
+		break;
+	}
+
+	cleanCancelled();
+}
+
+bool EventScheduler::cancelAll(void* owner, bool waitForRunning, int timeoutMs)
+{
+	if (owner == nullptr) return true;
+
+	{
+		GenericScopedLock lock(queueLock);
+		for (auto& t : queue)
+		{
+			if (t.owner != owner || t.func == nullptr) continue;
+			t.func = nullptr;
+			numCancelled++;
+		}
+
+		cleanCancelled();
+	}
+
+	if (!waitForRunning || Thread::getCurrentThreadId() == getThreadId()) return true;
+
+	//without timeout, the task may use the owner until it returns
+	double startTime = Time::getMillisecondCounterHiRes();
+	while (runningOwner.load() == owner)
+	{
+		if (timeoutMs >= 0 && Time::getMillisecondCounterHiRes() - startTime >= timeoutMs) return false;
+		taskFinished.wait(5);
+	}
+
+	return true;
+}
+
+int EventScheduler::getNumPendingTasks()
+{
+	GenericScopedLock lock(queueLock);
+	return (int)queue.size() - numCancelled;
+}
+
+void EventScheduler::cleanCancelled()
+{
+	//cancelled tasks are left in the heap and skipped, it is only rebuilt when they are the majority
+	if (numCancelled < 64 || numCancelled * 2 < (int)queue.size()) return;
+
+	queue.erase(std::remove_if(queue.begin(), queue.end(), [](const Task& t) { return t.func == nullptr; }), queue.end());
+	std::make_heap(queue.begin(), queue.end(), taskIsLater);
+	numCancelled = 0;
+}
+
+void EventScheduler::run()
+{
+	while (!threadShouldExit())
+	{
+		Task task;
+		double waitTime = -1;
+
+		{
+			GenericScopedLock lock(queueLock);
+			if (!queue.empty())
+			{
+				double remaining = queue.front().time - Time::getMillisecondCounterHiRes();
+				if (remaining <= 0)
+				{
+					std::pop_heap(queue.begin(), queue.end(), taskIsLater);
+					task = std::move(queue.back());
+					queue.pop_back();
+
+					if (task.func == nullptr)
+					{
+						numCancelled--;
+						continue;
+					}
+
+					runningOwner = task.owner;
+				}
+				else
+				{
+					waitTime = remaining;
+				}
+			}
+		}
+
+		if (task.func != nullptr)
+		{
+			task.func();
+			runningOwner = nullptr;
+			taskFinished.signal();
+			continue;
+		}
+
+		if (waitTime < 0) wait(-1); //notify() is called when a task is added
+		else if (waitTime > 2) wait((int)waitTime - 1); //system waits are only precise to the millisecond
+		else Thread::yield();
+	}
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    EventScheduler.h
+    Created: 18 Oct 2026 9:47:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Engine-wide scheduler for delayed actions, one thread for all of them instead of one thread per delayed trigger.
+	Tasks are kept in a min-heap ordered by due time (Time::getMillisecondCounterHiRes() values), tasks due at the same time run in the order they were scheduled.
+	The thread sleeps until the next task is close and yields for the last millisecond, so tasks run well under a millisecond late.
+	Tasks are run on the scheduler thread, they must not wait for the message thread as it may be waiting for them to finish in cancelAll.
+	Owners whose tasks may wait for it anyway (outputs taking the MessageManagerLock) cancel with a timeout and guard their tasks with an OwnerLiveness.
+*/
+
+class EventScheduler :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(EventScheduler, true)
+	EventScheduler(const String& name = "Event Scheduler");
+	~EventScheduler();
+
+	typedef uint64 TaskID;
+
+	//Shared by an owner and its tasks, the owner marks it dead before cancelling so a task still running after a timed out cancelAll stops using it
+	class OwnerLiveness :
+		public ReferenceCountedObject
+	{
+	public:
+		std::atomic<bool> isAlive{ true };
+		typedef ReferenceCountedObjectPtr<OwnerLiveness> Ptr;
+	};
+
+	struct Task
+	{
+		double time;
+		TaskID id;
+		void* owner;
+		std::function<void()> func; //empty once cancelled
+	};
+
+	//Schedules func to run at the given time, owner can be anything identifying the tasks to cancel them together
+	TaskID scheduleAt(double timeMillis, std::function<void()> func, void* owner = nullptr);
+	TaskID schedule(double delayMillis, std::function<void()> func, void* owner = nullptr);
+
+	void cancel(TaskID id);
+	//Cancels all pending tasks of owner, and if waitForRunning is true blocks until the one of owner that is running has returned, so the owner can be deleted
+	//With a timeout, returns false if that task is still running when it expires
+	bool cancelAll(void* owner, bool waitForRunning = true, int timeoutMs = -1);
+
+	int getNumPendingTasks();
+
+	void run() override;
+
+private:
+	CriticalSection queueLock;
+	std::vector<Task> queue; //heap
+	TaskID idIncrement;
+	int numCancelled;
+
+	std::atomic<void*> runningOwner;
+	WaitableEvent taskFinished;
+
+	void cleanCancelled();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EventScheduler)
+};
+
+/*
+	Scheduler for continuous processing (mappings with time-based filters), kept apart so long processing never delays the event tasks.
+	Processors park and unpark themselves on it instead of starting and stopping a thread each.
+	All of them share this one thread, their processes run one after the other : a process longer than its interval delays the others,
+	late processes are not piled up but run as soon as the thread is free.
+*/
+class ContinuousProcessScheduler :
+	public EventScheduler
+{
+public:
+	juce_DeclareSingleton(ContinuousProcessScheduler, true)
+	ContinuousProcessScheduler() : EventScheduler("Continuous Process") {}
+	~ContinuousProcessScheduler() {}
+};
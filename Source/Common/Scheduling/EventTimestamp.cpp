@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    EventTimestamp.cpp
+    Created: 18 Oct 2026 6:40:11pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+thread_local double EventTimestamp::currentTimestamp = 0;
+thread_local void* EventTimestamp::currentSource = nullptr;
+
+double EventTimestamp::getDelayMillis()
+{
+	if (currentTimestamp <= 0) return 0;
+	return jmax(0.0, currentTimestamp - Time::getMillisecondCounterHiRes());
+}
+
+bool EventTimestamp::scheduleAtTimestamp(std::function<void()> func)
+{
+	if (getDelayMillis() < 1) return false;
+	EventScheduler::getInstance()->scheduleAt(currentTimestamp, func, currentSource);
+	return true;
+}
+
+void EventTimestamp::cancelScheduled(void* source)
+{
+	if (source == nullptr || EventScheduler::getInstanceWithoutCreating() == nullptr) return;
+	EventScheduler::getInstance()->cancelAll(source, false);
+}
+
+EventTimestamp::Scope::Scope(double timestamp, void* source) :
+	previousTimestamp(currentTimestamp),
+	previousSource(currentSource)
+{
+	currentTimestamp = timestamp;
+	currentSource = source;
+}
+
+EventTimestamp::Scope::~Scope()
+{
+	currentTimestamp = previousTimestamp;
+	currentSource = previousSource;
+}
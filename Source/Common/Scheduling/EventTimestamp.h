@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    EventTimestamp.h
+    Created: 18 Oct 2026 6:40:11pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Target time of the event being processed on the current thread, as a Time::getMillisecondCounterHiRes() value.
+	Sequences set it when they evaluate triggers ahead of time, outputs that can schedule (MIDI, OSC) use it to send
+	at the exact time instead of right away. 0 means now.
+	Scheduled outputs are tasks of the EventScheduler owned by the source of the timestamp, so the source can cancel them (e.g. a sequence that stops or seeks).
+*/
+class EventTimestamp
+{
+public:
+	static double get() { return currentTimestamp; }
+	static void* getSource() { return currentSource; }
+	static double getDelayMillis();
+
+	//Runs func at the current timestamp if it is ahead and returns true, returns false if it should be run right away
+	static bool scheduleAtTimestamp(std::function<void()> func);
+	static void cancelScheduled(void* source);
+
+	class Scope
+	{
+	public:
+		Scope(double timestamp, void* source = nullptr);
+		~Scope();
+
+	private:
+		double previousTimestamp;
+		void* previousSource;
+	};
+
+private:
+	static thread_local double currentTimestamp;
+	static thread_local void* currentSource;
+};
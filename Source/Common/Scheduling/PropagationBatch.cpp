@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    PropagationBatch.cpp
+    Created: 18 Oct 2026 11:57:31pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+thread_local PropagationBatch* PropagationBatch::currentBatch = nullptr;
+
+PropagationBatch::PropagationBatch() :
+	isOutermost(currentBatch == nullptr)
+{
+	if (isOutermost) currentBatch = this;
+}
+
+PropagationBatch::~PropagationBatch()
+{
+	if (!isOutermost) return;
+
+	run();
+	currentBatch = nullptr;
+}
+
+bool PropagationBatch::isActive()
+{
+	return currentBatch != nullptr;
+}
+
+bool PropagationBatch::defer(Inspectable* owner, int key, std::function<void()> func)
+{
+	if (currentBatch == nullptr) return false;
+	if (hasKey(currentBatch->doneKeys, owner, key)) return false;
+	if (hasKey(currentBatch->pendingKeys, owner, key)) return true;
+
+	addKey(currentBatch->pendingKeys, owner, key);
+	currentBatch->tasks.add({ owner, owner, key, func });
+	return true;
+}
+
+void PropagationBatch::run()
+{
+	//tasks may defer other tasks, they are added at the end and run in this loop
+	for (int i = 0; i < tasks.size(); i++)
+	{
+		Task t = tasks[i];
+		removeKey(pendingKeys, t.ownerKey, t.key);
+		addKey(doneKeys, t.ownerKey, t.key);
+
+		if (t.owner.wasObjectDeleted()) continue;
+		t.func();
+	}
+
+	tasks.clear();
+	pendingKeys.clear();
+	doneKeys.clear();
+}
+
+bool PropagationBatch::hasKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key)
+{
+	return map.contains(owner) && map[owner].contains(key);
+}
+
+void PropagationBatch::addKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key)
+{
+	Array<int> keys = map[owner];
+	keys.addIfNotAlreadyThere(key);
+	map.set(owner, keys);
+}
+
+void PropagationBatch::removeKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key)
+{
+	Array<int> keys = map[owner];
+	keys.removeFirstMatchingValue(key);
+	if (keys.isEmpty()) map.remove(owner);
+	else map.set(owner, keys);
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    PropagationBatch.h
+    Created: 18 Oct 2026 11:57:31pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Scoped batch of value changes on the current thread, e.g. a scene recalling presets on many custom variable groups.
+	While a batch is open, downstream work (mapping processing, condition evaluation) is deferred to the end of the batch
+	instead of running on each change, and each owner / key pair only runs once with the final values.
+	Batches can be nested, only the outermost one runs the deferred work. Work deferred while running is run in the same wave,
+	work that already ran in this batch is not deferred again so feedback loops behave as without a batch.
+*/
+class PropagationBatch
+{
+public:
+	PropagationBatch();
+	~PropagationBatch();
+
+	struct Task
+	{
+		WeakReference<Inspectable> owner;
+		Inspectable* ownerKey;
+		int key;
+		std::function<void()> func;
+	};
+
+	Array<Task> tasks;
+	HashMap<Inspectable*, Array<int>> pendingKeys;
+	HashMap<Inspectable*, Array<int>> doneKeys;
+
+	static bool isActive();
+
+	//Returns false if no batch is open, the caller should then do the work right away
+	static bool defer(Inspectable* owner, int key, std::function<void()> func);
+
+private:
+	bool isOutermost;
+	void run();
+
+	static bool hasKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key);
+	static void addKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key);
+	static void removeKey(HashMap<Inspectable*, Array<int>>& map, Inspectable* owner, int key);
+
+	static thread_local PropagationBatch* currentBatch;
+
+	JUCE_DECLARE_NON_COPYABLE(PropagationBatch)
+};
@@ -37,17 +37,7 @@ SerialDevice::~SerialDevice()
 void SerialDevice::setMode(PortMode _mode)
 {
 	if (mode == _mode) return; //do nothing if the same
-
-	if (_mode == LINES) //must restart to make sure thread is not hanging in readLine
-	{
-		if (thread.isThreadRunning())
-		{
-			thread.stopThread(1000);
-			thread.startThread();
-		}
-	}
-
-	mode = _mode;
+	mode = _mode; //the read thread resets its partial frame when it sees the mode change
 }
 
 void SerialDevice::setBaudRate(int baudRate)
@@ -79,11 +69,7 @@ void SerialDevice::open(int baud)
 		if (!thread.isThreadRunning())
 		{
 			thread.startThread();
-#ifdef SYNCHRONOUS_SERIAL_LISTENERS
 			thread.addSerialListener(this);
-#else
-			thread.addAsyncSerialListener(this);
-#endif
 			listeners.call(&SerialDeviceListener::portOpened, this);
 		}
 
@@ -103,13 +89,7 @@ void SerialDevice::close()
 #if SERIALSUPPORT
 	if (isOpen())
 	{
-
-
-#ifdef SYNCHRONOUS_SERIAL_LISTENERS
 		thread.removeSerialListener(this);
-#else
-		thread.removeAsyncSerialListener(this);
-#endif
 
 		thread.stopThread(1000);
 
@@ -191,8 +171,12 @@ void SerialDevice::removeSerialDeviceListener(SerialDeviceListener * listener) {
 
 SerialReadThread::SerialReadThread(String name, SerialDevice * _port) :
 	Thread(name + "_thread"),
-	port(_port)
+	port(_port),
+	lastMode(-1),
+	lastFrameTime(0)
 {
+	readBuffer.malloc(readBufferSize);
+	frameBuffer.reserve(readBufferSize);
 }
 
 SerialReadThread::~SerialReadThread()
@@ -203,93 +187,167 @@ SerialReadThread::~SerialReadThread()
 void SerialReadThread::run()
 {
 #if SERIALSUPPORT
-	
-	std::vector<uint8_t> byteBuffer; //for cobs and data255
 
 	DBG("START SERIAL THREAD");
 
-	while (!threadShouldExit())
+#if !JUCE_WINDOWS
+	if (port != nullptr && port->port != nullptr)
 	{
-		sleep(2); //500fps
+		//waitReadable uses the read timeout, keep it short so the thread can exit quickly
+		serial::Timeout timeout = port->port->getTimeout();
+		timeout.read_timeout_constant = 100;
+		port->port->setTimeout(timeout);
+	}
+#endif
 
+	while (!threadShouldExit())
+	{
 		if (port == nullptr) return;
 		if (!port->isOpen()) return;
 
 		try
 		{
+			if (!waitForData()) continue;
 
-			size_t numBytes = (int)port->port->available();
-			if (numBytes == 0) continue;
-
-			switch (port->mode)
-			{
-
-			case SerialDevice::PortMode::LINES:
+			size_t numBytes = port->port->available();
+			while (numBytes > 0 && !threadShouldExit())
 			{
-				while (port->port->available() && port->mode == SerialDevice::PortMode::LINES)
-				{
-					std::string line = port->port->readline();
-					if(line.size() > 0) serialThreadListeners.call(&SerialThreadListener::dataReceived, var(line));
-				}
+				size_t numRead = port->port->read(readBuffer.get(), jmin<size_t>(numBytes, readBufferSize));
+				if (numRead == 0) break;
+				processBlock(readBuffer.get(), numRead);
+				numBytes = port->port->available();
 			}
-			break;
+		}
+		catch (...)
+		{
+			DBG("### Serial Problem ");
+			wait(10); //avoid spinning if the port is failing
+		}
+	}
 
-			case SerialDevice::PortMode::RAW:
-			{
-				std::vector<uint8_t> data;
-				port->port->read(data,numBytes);
-				//for (int i = 0; i < data.size(); ++i) DBG("Data " << data[i]);
-				serialThreadListeners.call(&SerialThreadListener::dataReceived, var(data.data(),numBytes));
-			}
-			break;
+	DBG("END SERIAL THREAD");
+#endif
 
-			case SerialDevice::PortMode::DATA255:
+}
+
+bool SerialReadThread::waitForData()
+{
+#if SERIALSUPPORT
+#if JUCE_WINDOWS
+	//waitReadable is not implemented on Windows, fall back to polling
+	if (port->port->available() > 0) return true;
+	wait(1);
+	return false;
+#else
+	return port->port->waitReadable();
+#endif
+#else
+	return false;
+#endif
+}
+
+void SerialReadThread::processBlock(const uint8_t* data, size_t numBytes)
+{
+	SerialDevice::PortMode mode = port->mode;
+	if (mode != lastMode)
+	{
+		frameBuffer.clear();
+		lastMode = mode;
+	}
+
+	switch (mode)
+	{
+	case SerialDevice::PortMode::RAW:
+		dispatchFrame(var(data, numBytes));
+		break;
+
+	case SerialDevice::PortMode::LINES:
+	{
+		for (size_t i = 0; i < numBytes; ++i)
+		{
+			frameBuffer.push_back(data[i]);
+			if (data[i] == '\n')
 			{
-				while (port->port->available() && port->mode == SerialDevice::PortMode::DATA255)
-				{
-					uint8_t b = port->port->read(1)[0];
-					if (b == 255)
-					{
-						serialThreadListeners.call(&SerialThreadListener::dataReceived, var(byteBuffer.data(),byteBuffer.size()));
-						byteBuffer.clear();
-					}
-					else
-					{
-						byteBuffer.push_back(b);
-					}
-				}
+				dispatchFrame(var(String::fromUTF8((const char*)frameBuffer.data(), (int)frameBuffer.size())));
+				frameBuffer.clear();
 			}
-			break;
+		}
+	}
+	break;
 
-			case SerialDevice::PortMode::COBS:
+	case SerialDevice::PortMode::DATA255:
+	{
+		size_t frameStart = 0;
+		for (size_t i = 0; i < numBytes; ++i)
+		{
+			if (data[i] != 255) continue;
+
+			if (frameBuffer.empty()) dispatchFrame(var(data + frameStart, i - frameStart));
+			else
 			{
-				while (port->port->available() && port->mode == SerialDevice::PortMode::COBS)
-				{
-					uint8_t b = port->port->read(1)[0];
-					byteBuffer.push_back(b);
-					if (b == 0)
-					{
-						uint8_t decodedData[255];
-						size_t numDecoded = cobs_decode(byteBuffer.data(), byteBuffer.size(), decodedData);
-						serialThreadListeners.call(&SerialThreadListener::dataReceived, var(decodedData, numDecoded - 1));
-						byteBuffer.clear();
-					}
-				}				
-			}
-			break;
+				frameBuffer.insert(frameBuffer.end(), data + frameStart, data + i);
+				dispatchFrame(var(frameBuffer.data(), frameBuffer.size()));
+				frameBuffer.clear();
 			}
+
+			frameStart = i + 1;
 		}
-		catch (...)
+
+		frameBuffer.insert(frameBuffer.end(), data + frameStart, data + numBytes);
+	}
+	break;
+
+	case SerialDevice::PortMode::COBS:
+	{
+		for (size_t i = 0; i < numBytes; ++i)
 		{
-			DBG("### Serial Problem ");
-		}
+			frameBuffer.push_back(data[i]);
+			if (data[i] != 0) continue;
 
-		
+			decodeBuffer.resize(frameBuffer.size());
+			size_t numDecoded = cobs_decode(frameBuffer.data(), frameBuffer.size(), decodeBuffer.data());
+			if (numDecoded > 0) dispatchFrame(var(decodeBuffer.data(), numDecoded - 1));
+			frameBuffer.clear();
+		}
+	}
+	break;
 	}
+}
 
-	DBG("END SERIAL THREAD");
-#endif
+void SerialReadThread::dispatchFrame(const var& data)
+{
+	lastFrameTime = Time::getMillisecondCounterHiRes();
+	serialThreadListeners.call(&SerialThreadListener::dataReceived, data);
+}
+
+const double SerialLatencyHistogram::bucketLimits[SerialLatencyHistogram::numBuckets - 1] = { .5, 1, 2, 5, 10, 50, 100 };
 
+SerialLatencyHistogram::SerialLatencyHistogram()
+{
+	reset();
+}
+
+void SerialLatencyHistogram::addValue(double latencyMs)
+{
+	int index = 0;
+	while (index < numBuckets - 1 && latencyMs >= bucketLimits[index]) index++;
+	counts[index]++;
+	totalCount++;
+	if (latencyMs > maxLatency.load()) maxLatency = latencyMs;
+}
+
+void SerialLatencyHistogram::reset()
+{
+	for (int i = 0; i < numBuckets; ++i) counts[i] = 0;
+	totalCount = 0;
+	maxLatency = 0;
+}
+
+String SerialLatencyHistogram::getBucketName(int index)
+{
+	if (index == 0) return "< " + String(bucketLimits[0]) + " ms";
+	if (index >= numBuckets - 1) return "> " + String(bucketLimits[numBuckets - 2]) + " ms";
+	return String(bucketLimits[index - 1]) + " - " + String(bucketLimits[index]) + " ms";
 }
 
 SerialDeviceInfo::SerialDeviceInfo(String _port, String _description, String _hardwareID) :
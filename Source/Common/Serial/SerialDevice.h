@@ -10,8 +10,6 @@
 
 #pragma once
 
-#define SYNCHRONOUS_SERIAL_LISTENERS
-
 #define SERIALSUPPORT 1
 
 #if SERIALSUPPORT
@@ -31,8 +29,20 @@ public:
 
 	SerialDevice * port;
 
+	//Incoming bytes are read in blocks into readBuffer, frameBuffer keeps the partial frame between two reads
+	static const int readBufferSize = 4096;
+	HeapBlock<uint8_t> readBuffer;
+	std::vector<uint8_t> frameBuffer;
+	std::vector<uint8_t> decodeBuffer; //for cobs
+	int lastMode;
+	double lastFrameTime; //time at which the frame being dispatched was read, used for latency measurement
+
 	virtual void run() override;
 
+	bool waitForData();
+	void processBlock(const uint8_t* data, size_t numBytes);
+	void dispatchFrame(const var& data);
+
 
 	class SerialThreadListener {
 	public:
@@ -63,12 +73,28 @@ public:
 	int pid;
 };
 
+class SerialLatencyHistogram
+{
+public:
+	SerialLatencyHistogram();
+	~SerialLatencyHistogram() {}
+
+	//Upper limits in ms of each bucket, the last bucket takes everything above
+	static const int numBuckets = 8;
+	static const double bucketLimits[numBuckets - 1];
+
+	std::atomic<int> counts[numBuckets];
+	std::atomic<int> totalCount;
+	std::atomic<double> maxLatency;
+
+	void addValue(double latencyMs);
+	void reset();
+
+	static String getBucketName(int index);
+};
+
 class SerialDevice :
-#ifdef SYNCHRONOUS_SERIAL_LISTENERS
 	public SerialReadThread::SerialThreadListener
-#else
-	public SerialReadThread::AsyncListener
-#endif
 {
 public:
 	SerialReadThread thread;
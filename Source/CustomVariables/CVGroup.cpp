@@ -8,15 +8,17 @@
   ==============================================================================
 */
 
+#include "Module/ModuleIncludes.h"
+
 CVGroup::CVGroup(const String & name) :
 	BaseItem(name),
-	Thread("CV Interpolation"),
 	params("Parameters"),
 	values("Variables",false, false, true, true),
+	presetMatrix(this),
+	bank(this),
 	defaultInterpolation("Default Preset Interpolation"),
-    targetPreset(nullptr),
-    interpolationAutomation(nullptr),
-    interpolationTime(0)
+	interpolationGeneration(0),
+	interpolationLiveness(new EventScheduler::OwnerLiveness())
 {
 	itemDataType = "CVGroup";
 
@@ -26,12 +28,13 @@ CVGroup::CVGroup(const String & name) :
 	addChildControllableContainer(&params);
 	addChildControllableContainer(&values);
 	addChildControllableContainer(pm.get());
+	addChildControllableContainer(&bank);
 	
 	controlMode = params.addEnumParameter("Control Mode", "Defines how the variables are controlled.\n \
 Free mode lets you can change manually the values or tween them to preset values punctually.\n \
 Weights mode locks the values and interpolate them continuously depending on preset weights.\n \
-Voronoi and Gradient Band (not implemented yet) also locks values but interpolates them using 2D interpolators");
-	controlMode->addOption("Free", FREE)->addOption("Weights", WEIGHTS)->addOption("2D Voronoi", VORONOI);// ->addOption("Gradient Band", GRADIENT_BAND);
+Voronoi and Gradient Band also locks values but interpolates them using 2D interpolators");
+	controlMode->addOption("Free", FREE)->addOption("Weights", WEIGHTS)->addOption("2D Voronoi", VORONOI)->addOption("Gradient Band", GRADIENT_BAND);
 
 	defaultInterpolation.isSelectable = false;
 	defaultInterpolation.length->setValue(1);
@@ -44,25 +47,82 @@ Voronoi and Gradient Band (not implemented yet) also locks values but interpolat
 	addChildControllableContainer(&defaultInterpolation);
 
 	values.addBaseManagerListener(this);
+	pm->addBaseManagerListener(this);
 }
 
 CVGroup::~CVGroup()
 {
 	if(morpher != nullptr) morpher->removeMorpherListener(this);
-	stopThread(100);
+	values.removeBaseManagerListener(this);
+	pm->removeBaseManagerListener(this);
+
+	interpolationLiveness->isAlive = false;
+	stopInterpolation();
+	if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating())
+	{
+		scheduler->cancelAll(this, true, 100); //bounded, the values set by a running tick may wait for the message thread
+		scheduler->cancelAll(this, false); //a tick that was running may have scheduled the next one
+	}
 }
 
 void CVGroup::itemAdded(GenericControllableItem* item)
 {
 	item->controllable->userCanSetReadOnly = true;
+	presetMatrix.setDirty();
 }
 
 void CVGroup::itemsAdded(Array<GenericControllableItem*> items)
 {
 	for (auto& i : items) i->controllable->userCanSetReadOnly = true;
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemRemoved(GenericControllableItem* item)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemsRemoved(Array<GenericControllableItem*> items)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemAdded(CVPreset* preset)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemsAdded(Array<CVPreset*> presets)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemRemoved(CVPreset* preset)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemsRemoved(Array<CVPreset*> presets)
+{
+	presetMatrix.setDirty();
+}
+
+void CVGroup::itemsReordered()
+{
+	presetMatrix.setDirty();
 }
 
 void CVGroup::setValuesToPreset(CVPreset * preset)
+{
+	Array<Parameter*> params;
+	Array<var> presetValues;
+	getPresetValues(preset, params, presetValues);
+
+	PropagationBatch batch;
+	for (int i = 0; i < params.size(); i++) params[i]->setValue(presetValues[i]);
+}
+
+void CVGroup::getPresetValues(CVPreset* preset, Array<Parameter*>& params, Array<var>& presetValues)
 {
 	if (!enabled->boolValue()) return;
 
@@ -71,7 +131,10 @@ void CVGroup::setValuesToPreset(CVPreset * preset)
 		Parameter * p = dynamic_cast<Parameter *>(v->controllable);
 		if (p == nullptr) continue;
 		ParameterPreset * pp = preset->values.getParameterPresetForSource(p);
-		if (pp != nullptr) p->setValue(pp->parameter->value);
+		if (pp == nullptr) continue;
+
+		params.add(p);
+		presetValues.add(pp->parameter->value);
 	}
 }
 
@@ -106,58 +169,73 @@ void CVGroup::lerpPresets(CVPreset * p1, CVPreset * p2, float weight)
 	}
 }
 
-void CVGroup::lerpPresets(Array<var> sourceValues, CVPreset* endPreset, float weight)
+void CVGroup::goToPreset(CVPreset* p, float time, Automation* curve)
 {
-	int numValues = values.items.size();
-
-	jassert(sourceValues.size() == numValues);
-	if (endPreset == nullptr) return;
-
-	for (int i = 0; i < numValues; i++)
-	{
-		Parameter* p = dynamic_cast<Parameter*>(values.items[i]->controllable);
-		if (p == nullptr) continue;
-		var startValue = sourceValues[i];
-		ParameterPreset* endParam = endPreset->values.getParameterPresetForSource(p);
+	if (p == nullptr) return;
 
-		if (endParam != nullptr)
-		{
-			ParameterPreset::InterpolationMode mode = endParam->interpolationMode->getValueDataAsEnum<ParameterPreset::InterpolationMode>();
+	GenericScopedLock lock(interpolationLock);
 
-			if (mode == ParameterPreset::NONE) continue;
+	//a running interpolation is not stopped, the new one starts from its values so they cross-fade
+	interpolation = new CVPresetInterpolation(this, p, time, curve, interpolation.get());
+	startInterpolation();
+}
 
-			var tValue;
-			if (weight == 0) tValue =  startValue;
-			else if (weight == 1) tValue = endParam->parameter->value;
-			else
-			{
-				if (mode == ParameterPreset::INTERPOLATE) tValue = endParam->parameter->getLerpValueTo(startValue, 1-weight);
-				else tValue = mode == ParameterPreset::CHANGE_AT_END ? startValue : endParam->parameter->value;
-			}
+void CVGroup::goToBankRow(int row, float time, Automation* curve)
+{
+	if (!bank.isValidRow(row)) return;
 
-			p->setValue(tValue);
-		}
-	}
+	GenericScopedLock lock(interpolationLock);
+	interpolation = new CVPresetInterpolation(&bank, row, time, curve, interpolation.get());
+	startInterpolation();
 }
 
-void CVGroup::goToPreset(CVPreset* p, float time, Automation* curve)
+void CVGroup::startInterpolation()
 {
-	stopThread(1000);
+	GenericScopedLock lock(interpolationLock);
+	int generation = ++interpolationGeneration;
+	scheduleInterpolation(Time::getMillisecondCounterHiRes(), generation);
+}
 
-	targetPreset = p;
-	if (interpolationAutomation != nullptr) interpolationAutomation->removeInspectableListener(this);
-	interpolationAutomation = curve;
-	automationRef = curve;
-	if(interpolationAutomation != nullptr) interpolationAutomation->addInspectableListener(this);
+void CVGroup::scheduleInterpolation(double time, int generation)
+{
+	EventScheduler::OwnerLiveness::Ptr liveness = interpolationLiveness;
+	ContinuousProcessScheduler::getInstance()->scheduleAt(time, [this, generation, liveness]()
+		{
+			if (liveness->isAlive) processInterpolation(generation, liveness);
+		}, this);
+}
 
-	interpolationTime = time;
+void CVGroup::stopInterpolation()
+{
+	{
+		GenericScopedLock lock(interpolationLock);
+		interpolation = nullptr;
+		interpolationGeneration++;
+	}
 
-	startThread();
+	if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating()) scheduler->cancelAll(this, false);
 }
 
-void CVGroup::stopInterpolation()
+void CVGroup::processInterpolation(int generation, EventScheduler::OwnerLiveness::Ptr liveness)
 {
-	stopThread(1000);
+	ReferenceCountedObjectPtr<CVPresetInterpolation> i;
+	double time = Time::getMillisecondCounterHiRes();
+	{
+		//a go to from another thread freezes and releases the interrupted chain under this lock, so it is walked under it too
+		GenericScopedLock lock(interpolationLock);
+		if (generation != interpolationGeneration || interpolation == nullptr) return;
+		i = interpolation;
+		i->evaluate(time);
+	}
+
+	i->apply(); //outside of the lock, value listeners may start another interpolation
+	if (!liveness->isAlive) return; //deleted while applying
+
+	GenericScopedLock lock(interpolationLock);
+	if (generation != interpolationGeneration) return;
+
+	if (i->isFinished(time)) interpolation = nullptr;
+	else scheduleInterpolation(time + CV_INTERPOLATION_INTERVAL, generation);
 }
 
 void CVGroup::computeValues()
@@ -174,19 +252,7 @@ void CVGroup::computeValues()
 	case VORONOI:
 	case GRADIENT_BAND:
     case WEIGHTS:
-
-		for (auto &v : values.items)
-		{
-			Array<var> pValues;
-			Parameter * vp = static_cast<Parameter *>(v->controllable);
-			for (auto &p : pm->items)
-			{
-				ParameterPreset * spp = p->values.getParameterPresetForSource(vp);
-				if(spp != nullptr) pValues.add(spp->parameter->value);
-			}
-
-			if(pValues.size() == weights.size()) vp->setWeightedValue(pValues, weights);
-		}
+		presetMatrix.blend(weights);
 		break;
             
         default:
@@ -203,13 +269,13 @@ Array<float> CVGroup::getNormalizedPresetWeights()
 
 	for (auto &p : pm->items)
 	{
-		totalWeight += p->enabled->boolValue() ? p->weight->floatValue() : 0;
+		totalWeight += p->isBlendable() ? p->weight->floatValue() : 0;
 	}
 
 	
 	for (auto &p : pm->items)
 	{
-		float w = p->enabled->boolValue() ? p->weight->floatValue() : 0;
+		float w = p->isBlendable() ? p->weight->floatValue() : 0;
 		normalizedWeights.add(totalWeight > 0 ? w / totalWeight : 0);
 	}
 
@@ -239,9 +305,10 @@ void CVGroup::onControllableFeedbackUpdateInternal(ControllableContainer * cc, C
 			{
 				morpher.reset(new Morpher(pm.get()));
 				morpher->addMorpherListener(this);
-				morpher->blendMode = cm == VORONOI ? Morpher::VORONOI : Morpher::GRADIENT_BAND;
 				addChildControllableContainer(morpher.get());
 			}
+
+			morpher->setBlendMode(cm == VORONOI ? Morpher::VORONOI : Morpher::GRADIENT_BAND);
 		}
 		else
 		{
@@ -256,13 +323,18 @@ void CVGroup::onControllableFeedbackUpdateInternal(ControllableContainer * cc, C
 
 		if(cm != FREE) computeValues();
 
-	} else if(controlMode->getValueDataAsEnum<ControlMode>() == WEIGHTS)
+	} else
 	{
 		CVPreset * p = c->getParentAs<CVPreset>();
 		if (p == nullptr) p = dynamic_cast<CVPreset *>(c->parentContainer->parentContainer.get()); //if value
 		if (p != nullptr)
 		{
-			computeValues();
+			if (ParameterPreset* pp = dynamic_cast<ParameterPreset*>(c->parentContainer.get()))
+			{
+				if (c == pp->parameter) presetMatrix.presetValueChanged(p, pp);
+			}
+
+			if (controlMode->getValueDataAsEnum<ControlMode>() == WEIGHTS) computeValues();
 		}
 	}
 }
@@ -273,6 +345,7 @@ var CVGroup::getJSONData()
 	data.getDynamicObject()->setProperty("params", params.getJSONData()); //keep "params" to avoid conflict with container's parameter
 	data.getDynamicObject()->setProperty(values.shortName, values.getJSONData());
 	data.getDynamicObject()->setProperty(pm->shortName, pm->getJSONData());
+	data.getDynamicObject()->setProperty(bank.shortName, bank.getJSONData());
 	if(morpher != nullptr) data.getDynamicObject()->setProperty(morpher->shortName, morpher->getJSONData());
 	return data;
 }
@@ -283,6 +356,7 @@ void CVGroup::loadJSONDataInternal(var data)
 	params.loadJSONData(data.getProperty("params", var())); //keep "params" to avoid conflict with container's parameter
 	values.loadJSONData(data.getProperty(values.shortName , var()));
 	pm->loadJSONData(data.getProperty(pm->shortName, var()));
+	bank.loadJSONData(data.getProperty(bank.shortName, var()));
 	
 	if (morpher != nullptr)
 	{
@@ -295,54 +369,3 @@ void CVGroup::loadJSONDataInternal(var data)
 		computeValues();
 	}
 }
-
-void CVGroup::inspectableDestroyed(Inspectable* i)
-{
-	if (i == interpolationAutomation)
-	{
-		stopThread(1000);
-	}
-}
-
-void CVGroup::run()
-{
-	if (targetPreset == nullptr || interpolationAutomation == nullptr || interpolationTime <= 0) return;
-
-
-	Array<var> sourceValues;
-	for (auto& v : values.items) sourceValues.add(((Parameter*)v->controllable)->value);
-
-	CVPreset p2(this);
-	p2.loadJSONData(targetPreset->getJSONData());
-	for (auto& v : p2.values.manager->items)
-	{
-		if (Parameter* p = dynamic_cast<Parameter*>(v->controllable)) p->isOverriden = true; //force use
-	}
-
-	Automation a;
-	a.isSelectable = false;
-	a.hideInEditor = true;
-	a.loadJSONData(interpolationAutomation->getJSONData());
-
-	float timeAtStart = Time::getMillisecondCounter() / 1000.0f;
-
-	while (!threadShouldExit() && !automationRef.wasObjectDeleted())
-	{
-		float curTime = Time::getMillisecondCounter() / 1000.0f;
-		float rel = jlimit(0.f, 1.f, (curTime - timeAtStart) / interpolationTime);
-
-		float weight = interpolationAutomation->getValueAtPosition(rel);
-		lerpPresets(sourceValues, &p2, weight);
-
-		if (rel == 1) break;
-
-		wait(20); //50fps
-	}
-
-	if (interpolationAutomation != nullptr)
-	{
-		interpolationAutomation->removeInspectableListener(this);
-		interpolationAutomation = nullptr;
-		automationRef = nullptr;
-	}
-}
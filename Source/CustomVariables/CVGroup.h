@@ -12,13 +12,13 @@
 
 class CVPreset;
 class CVPresetManager;
+class CVPresetInterpolation;
 
 class CVGroup :
 	public BaseItem,
 	public Morpher::MorpherListener,
-	public Thread,
-	public Inspectable::InspectableListener,
-	public GenericControllableManager::ManagerListener
+	public GenericControllableManager::ManagerListener,
+	public CVPresetManager::ManagerListener
 {
 public:
 	CVGroup(const String &name = "Group");
@@ -34,23 +34,39 @@ public:
 	std::unique_ptr<CVPresetManager> pm;
 	std::unique_ptr<Morpher> morpher;
 
-	//Animated interpolation
+	CVPresetMatrix presetMatrix;
+	CVPresetBank bank;
+
+	//Animated interpolation, ticked on the ContinuousProcessScheduler
 	Automation defaultInterpolation;
 
-	CVPreset* targetPreset;
-	Automation* interpolationAutomation;
-	WeakReference<Inspectable> automationRef;
-	float interpolationTime;
+	CriticalSection interpolationLock;
+	ReferenceCountedObjectPtr<CVPresetInterpolation> interpolation;
+	int interpolationGeneration;
+	EventScheduler::OwnerLiveness::Ptr interpolationLiveness; //dead once the group is being deleted
 
 	void itemAdded(GenericControllableItem* item) override;
 	void itemsAdded(Array<GenericControllableItem*> item) override;
+	void itemRemoved(GenericControllableItem* item) override;
+	void itemsRemoved(Array<GenericControllableItem*> items) override;
+
+	void itemAdded(CVPreset* preset) override;
+	void itemsAdded(Array<CVPreset*> presets) override;
+	void itemRemoved(CVPreset* preset) override;
+	void itemsRemoved(Array<CVPreset*> presets) override;
+
+	void itemsReordered() override;
 	
 	void setValuesToPreset(CVPreset * preset);
+	void getPresetValues(CVPreset* preset, Array<Parameter*>& params, Array<var>& presetValues);
 	void lerpPresets(CVPreset * p1, CVPreset * p2, float weight);
-	void lerpPresets(Array<var> sourceValues, CVPreset* endPreset, float weight);
 
 	void goToPreset(CVPreset* p, float time, Automation* curve);
+	void goToBankRow(int row, float time, Automation* curve);
+	void startInterpolation();
 	void stopInterpolation();
+	void scheduleInterpolation(double time, int generation);
+	void processInterpolation(int generation, EventScheduler::OwnerLiveness::Ptr liveness);
 
 	void computeValues();
 	Array<float> getNormalizedPresetWeights();
@@ -61,8 +77,4 @@ public:
 
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
-
-	void inspectableDestroyed(Inspectable* i) override;
-
-	void run() override;
 };
\ No newline at end of file
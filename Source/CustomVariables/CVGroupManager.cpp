@@ -24,6 +24,19 @@ CVGroupManager::~CVGroupManager()
 {
 }
 
+void CVGroupManager::recallPresets(Array<CVPreset*> presets)
+{
+	Array<Parameter*> params;
+	Array<var> presetValues;
+	for (auto& p : presets)
+	{
+		if (p != nullptr && p->group != nullptr) p->group->getPresetValues(p, params, presetValues);
+	}
+
+	PropagationBatch batch;
+	for (int i = 0; i < params.size(); i++) params[i]->setValue(presetValues[i]);
+}
+
 ControllableContainer * CVGroupManager::showMenuAndGetContainer()
 {
 	PopupMenu menu;
@@ -23,6 +23,9 @@ public:
 
 	std::unique_ptr<CustomVariablesModule> module;
 
+	//Scene recall, all the values are read first then set in one propagation batch so downstream only sees the final state. Used by the Recall Presets command
+	void recallPresets(Array<CVPreset*> presets);
+
 	//Input values menu
 	static ControllableContainer * showMenuAndGetContainer();
 	static Controllable * showMenuAndGetVariable(const StringArray& typeFilters, const StringArray& excludeTypeFilters);
@@ -14,8 +14,12 @@
 #include "CVGroupManager.cpp"
 #include "Preset/CVPreset.cpp"
 #include "Preset/CVPresetManager.cpp"
+#include "Preset/CVPresetMatrix.cpp"
+#include "Preset/CVPresetBank.cpp"
+#include "Preset/CVPresetInterpolation.cpp"
 #include "Preset/Morpher/MorphTarget.cpp"
 
+#include "Preset/Morpher/MorpherSiteIndex.cpp"
 #include "Preset/Morpher/Morpher.cpp"
 
 #include "Preset/Morpher/ui/CVPresetMorphUI.cpp"
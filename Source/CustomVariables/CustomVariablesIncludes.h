@@ -16,8 +16,12 @@
 
 #include "Preset/CVPreset.h"
 #include "Preset/CVPresetManager.h"
+#include "Preset/CVPresetMatrix.h"
+#include "Preset/CVPresetBank.h"
+#include "Preset/CVPresetInterpolation.h"
 
 #include "Preset/Morpher/jc_voronoi.h"
+#include "Preset/Morpher/MorpherSiteIndex.h"
 #include "Preset/Morpher/Morpher.h"
 
 #include "CVGroup.h"
@@ -11,7 +11,8 @@
 CVPreset::CVPreset(CVGroup * group) :
 	MorphTarget("Preset"),
 	group(group),
-	values("Values",&group->values,false)
+	values("Values",&group->values,false),
+	isBankRow(false)
 {
 	jassert(group != nullptr);
 
@@ -39,6 +40,11 @@ CVPreset::~CVPreset()
 {
 }
 
+bool CVPreset::isBlendable()
+{
+	return enabled->boolValue() && !isBankRow;
+}
+
 var CVPreset::getJSONData()
 {
 	var data = MorphTarget::getJSONData();
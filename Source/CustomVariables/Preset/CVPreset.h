@@ -91,6 +91,9 @@ public:
 
 	PresetParameterContainer values;
 
+	bool isBankRow; //temporary preset of an opened bank row, it is saved in the bank and doesn't take part in weights or the morpher
+	bool isBlendable();
+
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
 
@@ -0,0 +1,536 @@
+/*
+  ==============================================================================
+
+    CVPresetBank.cpp
+    Created: 19 Oct 2026 12:21:40am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+CVPresetBank::CVPresetBank(CVGroup* group) :
+	ControllableContainer("Preset Bank"),
+	group(group),
+	numFloats(0),
+	numVars(0),
+	numRows(0),
+	openRowIndex(-1)
+{
+	editorIsCollapsed = true;
+
+	numRowsParam = addIntParameter("Rows", "Number of presets stored in the bank", 0, 0);
+	numRowsParam->setControllableFeedbackOnly(true);
+	numRowsParam->isSavable = false;
+
+	editRow = addIntParameter("Edit Row", "The row to open, close or remove", 1, 1);
+	addRowTrigger = addTrigger("Add Row", "Store the current values of the variables as a new row of the bank");
+	openRowTrigger = addTrigger("Open Row", "Create an editable preset from the edit row, changes to this preset are written back to the row");
+	closeRowTrigger = addTrigger("Close Row", "Write back the opened preset to its row and remove the preset");
+	removeRowTrigger = addTrigger("Remove Row", "Remove the edit row from the bank");
+	convertPresetsTrigger = addTrigger("Convert Presets", "Store all the presets of the group as new rows of the bank and remove them from the presets");
+
+	group->values.addBaseManagerListener(this);
+	rebuildColumns();
+}
+
+CVPresetBank::~CVPresetBank()
+{
+	if (CVPreset* preset = dynamic_cast<CVPreset*>(openPreset.get())) preset->removeControllableContainerListener(this);
+	group->values.removeBaseManagerListener(this);
+}
+
+void CVPresetBank::rebuildColumns()
+{
+	GenericScopedLock lock(bankLock);
+
+	Array<Column> oldColumns = columns;
+	int oldNumFloats = numFloats;
+	int oldNumVars = numVars;
+	Array<float> oldFloatData = floatData;
+	Array<var> oldVarData = varData;
+	Array<uint8> oldModeData = modeData;
+
+	columns.clearQuick();
+	numFloats = 0;
+	numVars = 0;
+
+	for (auto& item : group->values.items)
+	{
+		Parameter* p = dynamic_cast<Parameter*>(item->controllable);
+		if (p == nullptr) continue;
+
+		Column col;
+		col.source = p;
+		col.name = p->shortName;
+		col.type = p->type;
+		col.numComponents = CVPresetMatrix::getNumComponents(p);
+		col.dataIndex = col.numComponents > 0 ? numFloats : numVars;
+		if (col.numComponents > 0) numFloats += col.numComponents;
+		else numVars++;
+		columns.add(col);
+	}
+
+	floatData.clearQuick();
+	varData.clearQuick();
+	modeData.clearQuick();
+	floatData.insertMultiple(0, 0, numRows * numFloats);
+	varData.insertMultiple(0, var(), numRows * numVars);
+	modeData.insertMultiple(0, 0, numRows * columns.size());
+
+	//keep the data of the columns that are still there, new columns take the current value of their variable
+	for (int c = 0; c < columns.size(); c++)
+	{
+		const Column& col = columns.getReference(c);
+
+		int oldIndex = -1;
+		for (int o = 0; o < oldColumns.size(); o++)
+		{
+			const Column& oc = oldColumns.getReference(o);
+			bool sameSource = oc.source != nullptr ? oc.source == col.source : oc.name == col.name;
+			if (sameSource && oc.type == col.type && oc.numComponents == col.numComponents) oldIndex = o;
+		}
+
+		var defaultValue = col.source->value;
+		for (int r = 0; r < numRows; r++)
+		{
+			if (oldIndex >= 0)
+			{
+				const Column& oc = oldColumns.getReference(oldIndex);
+				if (col.numComponents > 0)
+				{
+					for (int i = 0; i < col.numComponents; i++) floatData.set(r * numFloats + col.dataIndex + i, oldFloatData[r * oldNumFloats + oc.dataIndex + i]);
+				}
+				else
+				{
+					varData.set(r * numVars + col.dataIndex, oldVarData[r * oldNumVars + oc.dataIndex]);
+				}
+
+				modeData.set(r * columns.size() + c, oldModeData[r * oldColumns.size() + oldIndex]);
+			}
+			else
+			{
+				setRowValue(r, col, defaultValue);
+				modeData.set(r * columns.size() + c, (uint8)getDefaultMode(col.numComponents));
+			}
+		}
+	}
+}
+
+bool CVPresetBank::isValidRow(int row)
+{
+	GenericScopedLock lock(bankLock);
+	return row >= 0 && row < numRows;
+}
+
+int CVPresetBank::addRowFromCurrentValues(const String& name)
+{
+	GenericScopedLock lock(bankLock);
+
+	int row = numRows++;
+	rowNames.add(name.isNotEmpty() ? name : "Preset " + String(numRows));
+	rowTimes.add(1);
+	floatData.insertMultiple(-1, 0, numFloats);
+	varData.insertMultiple(-1, var(), numVars);
+
+	for (auto& col : columns)
+	{
+		if (Parameter* p = col.source.get()) setRowValue(row, col, p->value);
+		modeData.add((uint8)getDefaultMode(col.numComponents));
+	}
+
+	updateNumRows();
+	return row;
+}
+
+int CVPresetBank::addRowFromPreset(CVPreset* preset)
+{
+	int row = addRowFromCurrentValues(preset->niceName);
+	storePresetInRow(preset, row);
+	return row;
+}
+
+void CVPresetBank::convertPresets()
+{
+	Array<CVPreset*> presets;
+	for (auto& p : group->pm->items) if (!p->isBankRow) presets.add(p);
+	if (presets.isEmpty()) return;
+
+	for (auto& p : presets) addRowFromPreset(p);
+	for (auto& p : presets) group->pm->removeItem(p, false);
+
+	NLOG(niceName, "Converted " << presets.size() << " presets to bank rows");
+}
+
+void CVPresetBank::removeRow(int row)
+{
+	{
+		GenericScopedLock lock(bankLock);
+		if (row < 0 || row >= numRows) return;
+
+		rowNames.remove(row);
+		rowTimes.remove(row);
+		floatData.removeRange(row * numFloats, numFloats);
+		varData.removeRange(row * numVars, numVars);
+		modeData.removeRange(row * columns.size(), columns.size());
+		numRows--;
+
+		if (openRowIndex == row) openRowIndex = -1;
+		else if (openRowIndex > row) openRowIndex--;
+	}
+
+	if (openRowIndex == -1 && openPreset != nullptr) closeRow();
+	updateNumRows();
+}
+
+void CVPresetBank::getRowValues(int row, Array<Parameter*>& params, Array<var>& rowValues, Array<int>* modes)
+{
+	GenericScopedLock lock(bankLock);
+	if (row < 0 || row >= numRows) return;
+
+	for (int c = 0; c < columns.size(); c++)
+	{
+		const Column& col = columns.getReference(c);
+		Parameter* p = col.source.get();
+		if (p == nullptr || p->type != col.type) continue;
+
+		params.add(p);
+		rowValues.add(getRowValue(row, col));
+		if (modes != nullptr) modes->add(modeData[row * columns.size() + c]);
+	}
+}
+
+float CVPresetBank::getRowTime(int row)
+{
+	GenericScopedLock lock(bankLock);
+	return rowTimes[row];
+}
+
+void CVPresetBank::setValuesToRow(int row)
+{
+	if (!group->enabled->boolValue()) return;
+
+	Array<Parameter*> params;
+	Array<var> rowValues;
+	getRowValues(row, params, rowValues);
+
+	PropagationBatch batch;
+	for (int i = 0; i < params.size(); i++) params[i]->setValue(rowValues[i]);
+}
+
+void CVPresetBank::lerpRows(int row1, int row2, float weight)
+{
+	if (!group->enabled->boolValue()) return;
+
+	Array<Parameter*> params;
+	Array<var> rowValues;
+	{
+		GenericScopedLock lock(bankLock);
+		if (row1 < 0 || row1 >= numRows || row2 < 0 || row2 >= numRows) return;
+
+		for (int c = 0; c < columns.size(); c++)
+		{
+			const Column& col = columns.getReference(c);
+			Parameter* p = col.source.get();
+			if (p == nullptr || p->type != col.type) continue;
+
+			ParameterPreset::InterpolationMode mode = (ParameterPreset::InterpolationMode)modeData[row2 * columns.size() + c];
+			if (mode == ParameterPreset::NONE) continue;
+
+			var tValue;
+			if (weight == 0) tValue = getRowValue(row1, col);
+			else if (weight == 1) tValue = getRowValue(row2, col);
+			else if (mode == ParameterPreset::INTERPOLATE && col.numComponents > 0)
+			{
+				float components[4];
+				const float* v1 = floatData.begin() + row1 * numFloats + col.dataIndex;
+				const float* v2 = floatData.begin() + row2 * numFloats + col.dataIndex;
+				for (int i = 0; i < col.numComponents; i++) components[i] = v1[i] + (v2[i] - v1[i]) * weight;
+				tValue = getComponentsValue(components, col.numComponents);
+			}
+			else
+			{
+				tValue = getRowValue(mode == ParameterPreset::CHANGE_AT_END ? row1 : row2, col);
+			}
+
+			params.add(p);
+			rowValues.add(tValue);
+		}
+	}
+
+	PropagationBatch batch;
+	for (int i = 0; i < params.size(); i++) params[i]->setValue(rowValues[i]);
+}
+
+void CVPresetBank::openRow(int row)
+{
+	if (!isValidRow(row)) return;
+	closeRow();
+
+	CVPreset* preset = new CVPreset(group);
+	preset->isBankRow = true;
+	preset->isSavable = false;
+	preset->setNiceName(rowNames[row]);
+	preset->defaultLoadTime->setValue(getRowTime(row));
+
+	Array<Parameter*> params;
+	Array<var> rowValues;
+	Array<int> modes;
+	getRowValues(row, params, rowValues, &modes);
+
+	for (int i = 0; i < params.size(); i++)
+	{
+		if (ParameterPreset* pp = preset->values.getParameterPresetForSource(params[i]))
+		{
+			pp->parameter->setValue(rowValues[i]);
+			pp->interpolationMode->setValueWithData(modes[i]);
+		}
+	}
+
+	openRowIndex = row;
+	openPreset = preset;
+	group->pm->addItem(preset, var(), false);
+	preset->addControllableContainerListener(this);
+	preset->selectThis();
+}
+
+void CVPresetBank::closeRow()
+{
+	CVPreset* preset = dynamic_cast<CVPreset*>(openPreset.get());
+	openPreset = nullptr;
+	if (preset == nullptr) return;
+
+	preset->removeControllableContainerListener(this);
+	if (isValidRow(openRowIndex)) storePresetInRow(preset, openRowIndex);
+	openRowIndex = -1;
+
+	group->pm->removeItem(preset, false);
+}
+
+void CVPresetBank::storePresetInRow(CVPreset* preset, int row)
+{
+	GenericScopedLock lock(bankLock);
+	if (row < 0 || row >= numRows) return;
+
+	rowNames.set(row, preset->niceName);
+	rowTimes.set(row, preset->defaultLoadTime->floatValue());
+
+	for (int c = 0; c < columns.size(); c++)
+	{
+		const Column& col = columns.getReference(c);
+		Parameter* p = col.source.get();
+		if (p == nullptr) continue;
+
+		ParameterPreset* pp = preset->values.getParameterPresetForSource(p);
+		if (pp == nullptr) continue;
+
+		setRowValue(row, col, pp->parameter->value);
+		modeData.set(row * columns.size() + c, (uint8)(int)pp->interpolationMode->getValueData());
+	}
+}
+
+void CVPresetBank::setRowValue(int row, const Column& col, const var& value)
+{
+	if (col.numComponents > 0) CVPresetMatrix::readComponents(value, floatData.begin() + row * numFloats + col.dataIndex, col.numComponents);
+	else varData.set(row * numVars + col.dataIndex, value);
+}
+
+var CVPresetBank::getRowValue(int row, const Column& col)
+{
+	if (col.numComponents > 0) return getComponentsValue(floatData.begin() + row * numFloats + col.dataIndex, col.numComponents);
+	return varData[row * numVars + col.dataIndex];
+}
+
+void CVPresetBank::updateNumRows()
+{
+	numRowsParam->setValue(numRows);
+	editRow->setRange(1, jmax(numRows, 1));
+}
+
+void CVPresetBank::itemAdded(GenericControllableItem*)
+{
+	rebuildColumns();
+}
+
+void CVPresetBank::itemsAdded(Array<GenericControllableItem*>)
+{
+	rebuildColumns();
+}
+
+void CVPresetBank::itemRemoved(GenericControllableItem*)
+{
+	rebuildColumns();
+}
+
+void CVPresetBank::itemsRemoved(Array<GenericControllableItem*>)
+{
+	rebuildColumns();
+}
+
+void CVPresetBank::itemsReordered()
+{
+	rebuildColumns();
+}
+
+void CVPresetBank::onContainerTriggerTriggered(Trigger* t)
+{
+	ControllableContainer::onContainerTriggerTriggered(t);
+
+	if (t == addRowTrigger) editRow->setValue(addRowFromCurrentValues() + 1);
+	else if (t == openRowTrigger) openRow(editRow->intValue() - 1);
+	else if (t == closeRowTrigger) closeRow();
+	else if (t == removeRowTrigger) removeRow(editRow->intValue() - 1);
+	else if (t == convertPresetsTrigger) convertPresets();
+}
+
+void CVPresetBank::onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
+{
+	ControllableContainer::onControllableFeedbackUpdate(cc, c);
+
+	CVPreset* preset = dynamic_cast<CVPreset*>(openPreset.get());
+	if (preset == nullptr) return;
+
+	//write back the edited value right away so commands recalling this row see it
+	GenericScopedLock lock(bankLock);
+	if (openRowIndex < 0 || openRowIndex >= numRows) return;
+
+	if (c == preset->defaultLoadTime)
+	{
+		rowTimes.set(openRowIndex, preset->defaultLoadTime->floatValue());
+		return;
+	}
+
+	ParameterPreset* pp = dynamic_cast<ParameterPreset*>(c->parentContainer.get());
+	if (pp == nullptr || pp->parentContainer != &preset->values) return;
+	if (c != pp->parameter && c != pp->interpolationMode) return;
+
+	Parameter* source = preset->values.linkMap[pp];
+	for (int i = 0; i < columns.size(); i++)
+	{
+		const Column& col = columns.getReference(i);
+		if (col.source != source) continue;
+
+		if (c == pp->parameter) setRowValue(openRowIndex, col, pp->parameter->value);
+		else modeData.set(openRowIndex * columns.size() + i, (uint8)(int)pp->interpolationMode->getValueData());
+		break;
+	}
+}
+
+var CVPresetBank::getJSONData()
+{
+	var data = ControllableContainer::getJSONData();
+
+	if (CVPreset* preset = dynamic_cast<CVPreset*>(openPreset.get()))
+	{
+		if (isValidRow(openRowIndex)) storePresetInRow(preset, openRowIndex);
+	}
+
+	GenericScopedLock lock(bankLock);
+
+	var columnsData;
+	for (auto& col : columns) columnsData.append(col.source != nullptr ? col.source->shortName : col.name);
+
+	var rowsData;
+	for (int r = 0; r < numRows; r++)
+	{
+		var rowValues;
+		var rowModes;
+		for (int c = 0; c < columns.size(); c++)
+		{
+			rowValues.append(getRowValue(r, columns.getReference(c)));
+			rowModes.append(modeData[r * columns.size() + c]);
+		}
+
+		var rowData;
+		rowData.append(rowNames[r]);
+		rowData.append(rowTimes[r]);
+		rowData.append(rowValues);
+		rowData.append(rowModes);
+		rowsData.append(rowData);
+	}
+
+	data.getDynamicObject()->setProperty("columns", columnsData);
+	data.getDynamicObject()->setProperty("rows", rowsData);
+	return data;
+}
+
+void CVPresetBank::loadJSONData(var data, bool createIfNotThere)
+{
+	ControllableContainer::loadJSONData(data, createIfNotThere);
+
+	closeRow();
+
+	{
+		GenericScopedLock lock(bankLock);
+
+		numRows = 0;
+		rowNames.clear();
+		rowTimes.clear();
+		floatData.clear();
+		varData.clear();
+		modeData.clear();
+	}
+
+	rebuildColumns();
+
+	var columnsData = data.getProperty("columns", var());
+	var rowsData = data.getProperty("rows", var());
+	if (!columnsData.isArray() || !rowsData.isArray())
+	{
+		updateNumRows();
+		return;
+	}
+
+	GenericScopedLock lock(bankLock);
+
+	//saved column index of each current column, -1 if the variable was not saved
+	Array<int> savedIndexes;
+	for (auto& col : columns)
+	{
+		int index = -1;
+		for (int i = 0; i < columnsData.size(); i++) if (columnsData[i].toString() == col.name) index = i;
+		savedIndexes.add(index);
+	}
+
+	numRows = rowsData.size();
+	rowNames.ensureStorageAllocated(numRows);
+	rowTimes.ensureStorageAllocated(numRows);
+	floatData.insertMultiple(0, 0, numRows * numFloats);
+	varData.insertMultiple(0, var(), numRows * numVars);
+	modeData.insertMultiple(0, 0, numRows * columns.size());
+
+	for (int r = 0; r < numRows; r++)
+	{
+		var rowData = rowsData[r];
+		var rowValues = rowData[2];
+		var rowModes = rowData[3];
+
+		rowNames.add(rowData[0].toString());
+		rowTimes.add(rowData[1]);
+
+		for (int c = 0; c < columns.size(); c++)
+		{
+			const Column& col = columns.getReference(c);
+			int index = savedIndexes[c];
+			bool hasValue = index >= 0 && index < rowValues.size();
+
+			setRowValue(r, col, hasValue ? rowValues[index] : col.source->value);
+			modeData.set(r * columns.size() + c, (uint8)(hasValue && index < rowModes.size() ? (int)rowModes[index] : getDefaultMode(col.numComponents)));
+		}
+	}
+
+	updateNumRows();
+}
+
+ParameterPreset::InterpolationMode CVPresetBank::getDefaultMode(int numComponents)
+{
+	return numComponents > 0 ? ParameterPreset::INTERPOLATE : ParameterPreset::CHANGE_AT_START;
+}
+
+var CVPresetBank::getComponentsValue(const float* components, int numComponents)
+{
+	if (numComponents == 1) return components[0];
+
+	var result;
+	for (int i = 0; i < numComponents; i++) result.append(components[i]);
+	return result;
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    CVPresetBank.h
+    Created: 19 Oct 2026 12:21:40am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class CVGroup;
+
+/*
+	Compact preset storage of a group, for generated cue lists of thousands of presets.
+	Each preset is a row of a typed table : float, int, point and color variables are stored as float components,
+	other variables as var, plus one interpolation mode per value. No container or parameter is created per row.
+	A row is only materialised as a regular CVPreset when opened for editing, edits are written back to the row.
+	That preset is not saved with the group's presets and is not blended, the bank saves the row with its edits.
+	Rows are recalled directly from the table by the bank commands, they don't take part in weights or the morpher.
+*/
+class CVPresetBank :
+	public ControllableContainer,
+	public GenericControllableManager::ManagerListener
+{
+public:
+	CVPresetBank(CVGroup* group);
+	~CVPresetBank();
+
+	struct Column
+	{
+		WeakReference<Parameter> source;
+		String name;
+		Controllable::Type type;
+		int numComponents; //0 if stored as var
+		int dataIndex; //first float of the row for components, var index of the row otherwise
+	};
+
+	CVGroup* group;
+
+	IntParameter* numRowsParam;
+	IntParameter* editRow;
+	Trigger* addRowTrigger;
+	Trigger* openRowTrigger;
+	Trigger* closeRowTrigger;
+	Trigger* removeRowTrigger;
+	Trigger* convertPresetsTrigger;
+
+	CriticalSection bankLock;
+	Array<Column> columns;
+	int numFloats; //per row
+	int numVars; //per row
+
+	int numRows;
+	StringArray rowNames;
+	Array<float> rowTimes;
+	Array<float> floatData; //numRows x numFloats
+	Array<var> varData; //numRows x numVars
+	Array<uint8> modeData; //numRows x columns
+
+	WeakReference<Inspectable> openPreset;
+	int openRowIndex;
+
+	void rebuildColumns();
+
+	bool isValidRow(int row);
+	int addRowFromCurrentValues(const String& name = String());
+	int addRowFromPreset(CVPreset* preset);
+	void convertPresets();
+	void removeRow(int row);
+
+	void getRowValues(int row, Array<Parameter*>& params, Array<var>& rowValues, Array<int>* modes = nullptr);
+	float getRowTime(int row);
+
+	void setValuesToRow(int row);
+	void lerpRows(int row1, int row2, float weight);
+
+	void openRow(int row);
+	void closeRow();
+	void storePresetInRow(CVPreset* preset, int row);
+
+	void itemAdded(GenericControllableItem*) override;
+	void itemsAdded(Array<GenericControllableItem*>) override;
+	void itemRemoved(GenericControllableItem*) override;
+	void itemsRemoved(Array<GenericControllableItem*>) override;
+	void itemsReordered() override;
+
+	void onContainerTriggerTriggered(Trigger* t) override;
+	void onControllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
+
+	var getJSONData() override;
+	void loadJSONData(var data, bool createIfNotThere = false) override;
+
+	static ParameterPreset::InterpolationMode getDefaultMode(int numComponents);
+	static var getComponentsValue(const float* components, int numComponents);
+
+private:
+	void setRowValue(int row, const Column& col, const var& value);
+	var getRowValue(int row, const Column& col);
+	void updateNumRows();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CVPresetBank)
+};
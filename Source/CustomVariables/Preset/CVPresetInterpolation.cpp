@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    CVPresetInterpolation.cpp
+    Created: 18 Oct 2026 10:31:08pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+CVPresetInterpolation::CVPresetInterpolation(CVGroup* group, CVPreset* target, float time, Automation* automation, CVPresetInterpolation* interrupted) :
+	startTime(Time::getMillisecondCounterHiRes()),
+	duration(jmax(0.f, time) * 1000),
+	previous(interrupted)
+{
+	init(automation);
+
+	for (auto& item : group->values.items)
+	{
+		Parameter* p = dynamic_cast<Parameter*>(item->controllable);
+		if (p == nullptr) continue;
+
+		ParameterPreset* pp = target->values.getParameterPresetForSource(p);
+		if (pp == nullptr) continue;
+
+		addValue(p, pp->parameter->value, pp->interpolationMode->getValueDataAsEnum<ParameterPreset::InterpolationMode>());
+	}
+}
+
+CVPresetInterpolation::CVPresetInterpolation(CVPresetBank* bank, int row, float time, Automation* automation, CVPresetInterpolation* interrupted) :
+	startTime(Time::getMillisecondCounterHiRes()),
+	duration(jmax(0.f, time) * 1000),
+	previous(interrupted)
+{
+	init(automation);
+
+	Array<Parameter*> params;
+	Array<var> rowValues;
+	Array<int> modes;
+	bank->getRowValues(row, params, rowValues, &modes);
+
+	for (int i = 0; i < params.size(); i++) addValue(params[i], rowValues[i], (ParameterPreset::InterpolationMode)modes[i]);
+}
+
+CVPresetInterpolation::~CVPresetInterpolation()
+{
+}
+
+void CVPresetInterpolation::init(Automation* automation)
+{
+	//only one interrupted interpolation is kept running, older ones stop where they are
+	if (previous != nullptr) previous->freezeStart();
+
+	for (int i = 0; i < CV_INTERPOLATION_CURVE_SIZE; i++)
+	{
+		float pos = i * 1.0f / (CV_INTERPOLATION_CURVE_SIZE - 1);
+		curve[i] = automation != nullptr ? automation->getValueAtPosition(pos) : pos;
+	}
+}
+
+void CVPresetInterpolation::addValue(Parameter* p, const var& target, ParameterPreset::InterpolationMode mode)
+{
+	if (mode == ParameterPreset::NONE) return;
+
+	Value v;
+	v.parameter = p;
+	v.type = p->type;
+	v.mode = mode;
+	v.isNumeric = CVPresetMatrix::getNumComponents(p) > 0;
+	v.previousIndex = -1;
+
+	if (previous != nullptr)
+	{
+		for (int i = 0; i < previous->values.size(); i++)
+		{
+			if (previous->values.getReference(i).parameter == p) v.previousIndex = i;
+		}
+	}
+
+	if (v.isNumeric)
+	{
+		v.numComponents = CVPresetMatrix::readComponents(p->value, v.start);
+		CVPresetMatrix::readComponents(target, v.end);
+		for (int i = 0; i < 4; i++) v.current[i] = v.start[i];
+	}
+	else
+	{
+		v.numComponents = 0;
+		v.startData = p->value;
+		v.endData = target;
+		v.currentData = v.startData;
+	}
+
+	values.add(v);
+}
+
+float CVPresetInterpolation::getWeight(double time) const
+{
+	if (duration <= 0) return 1;
+
+	float rel = jlimit(0.f, 1.f, (float)((time - startTime) / duration));
+	float pos = rel * (CV_INTERPOLATION_CURVE_SIZE - 1);
+	int index = jmin((int)pos, CV_INTERPOLATION_CURVE_SIZE - 2);
+	float frac = pos - index;
+	return curve[index] + (curve[index + 1] - curve[index]) * frac;
+}
+
+bool CVPresetInterpolation::isFinished(double time) const
+{
+	return time >= startTime + duration && (previous == nullptr || previous->isFinished(time));
+}
+
+void CVPresetInterpolation::evaluate(double time)
+{
+	if (previous != nullptr) previous->evaluate(time);
+
+	bool ended = time >= startTime + duration;
+	float weight = ended ? 1 : getWeight(time);
+
+	for (auto& v : values)
+	{
+		const Value* pv = v.previousIndex >= 0 ? &previous->values.getReference(v.previousIndex) : nullptr;
+
+		if (v.isNumeric)
+		{
+			const float* start = pv != nullptr ? pv->current : v.start;
+			for (int i = 0; i < v.numComponents; i++)
+			{
+				if (ended) v.current[i] = v.end[i];
+				else if (v.mode == ParameterPreset::INTERPOLATE) v.current[i] = start[i] + (v.end[i] - start[i]) * weight;
+				else v.current[i] = v.mode == ParameterPreset::CHANGE_AT_END ? start[i] : v.end[i];
+			}
+		}
+		else
+		{
+			const var& start = pv != nullptr ? pv->currentData : v.startData;
+			if (ended) v.currentData = v.endData;
+			else if (v.mode == ParameterPreset::INTERPOLATE) v.currentData = weight < .5f ? start : v.endData; //not interpolable, switch halfway
+			else v.currentData = v.mode == ParameterPreset::CHANGE_AT_END ? start : v.endData;
+		}
+	}
+}
+
+void CVPresetInterpolation::apply()
+{
+	for (auto& v : values)
+	{
+		Parameter* p = v.parameter.get();
+		if (p == nullptr || p->type != v.type) continue;
+
+		if (v.isNumeric) CVPresetMatrix::setComponents(p, v.current, v.numComponents);
+		else p->setValue(v.currentData);
+	}
+}
+
+void CVPresetInterpolation::freezeStart()
+{
+	if (previous == nullptr) return;
+
+	for (auto& v : values)
+	{
+		if (v.previousIndex < 0) continue;
+
+		const Value& pv = previous->values.getReference(v.previousIndex);
+		for (int i = 0; i < 4; i++) v.start[i] = pv.current[i];
+		v.startData = pv.currentData;
+		v.previousIndex = -1;
+	}
+
+	previous = nullptr;
+}
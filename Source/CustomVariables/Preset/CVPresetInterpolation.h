@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    CVPresetInterpolation.h
+    Created: 18 Oct 2026 10:31:08pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define CV_INTERPOLATION_CURVE_SIZE 256
+#define CV_INTERPOLATION_INTERVAL 20 //ms, 50fps
+
+class CVGroup;
+
+/*
+	Go to preset interpolation of a group.
+	Start and end values are taken once when it starts and the curve is sampled in a lookup table, so evaluating only reads these arrays.
+	When a go to interrupts a running one, the interrupted one keeps running as the start of the new one so they cross-fade instead of jumping.
+	The previous chain is changed by freezeStart, so evaluate and freezeStart must both be called with the group's interpolationLock held.
+	apply only reads the current values and can be called outside of it.
+*/
+class CVPresetInterpolation :
+	public ReferenceCountedObject
+{
+public:
+	CVPresetInterpolation(CVGroup* group, CVPreset* target, float time, Automation* curve, CVPresetInterpolation* previous = nullptr);
+	CVPresetInterpolation(CVPresetBank* bank, int row, float time, Automation* curve, CVPresetInterpolation* previous = nullptr);
+	~CVPresetInterpolation();
+
+	typedef ReferenceCountedObjectPtr<CVPresetInterpolation> Ptr;
+
+	struct Value
+	{
+		WeakReference<Parameter> parameter;
+		Controllable::Type type;
+		ParameterPreset::InterpolationMode mode;
+		bool isNumeric; //float, int, point and color values are interpolated by component, others only switch
+		int numComponents;
+		int previousIndex; //index of the same parameter in the interrupted interpolation, -1 if it starts from a fixed value
+
+		float start[4];
+		float end[4];
+		float current[4];
+		var startData;
+		var endData;
+		var currentData;
+	};
+
+	Array<Value> values;
+	float curve[CV_INTERPOLATION_CURVE_SIZE];
+	double startTime;
+	double duration;
+
+	Ptr previous; //interrupted interpolation, faded out by this one
+
+	float getWeight(double time) const;
+	bool isFinished(double time) const;
+
+	void evaluate(double time);
+	void apply();
+
+	void freezeStart();
+
+private:
+	void init(Automation* curve);
+	void addValue(Parameter* p, const var& target, ParameterPreset::InterpolationMode mode);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CVPresetInterpolation)
+};
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    CVPresetMatrix.cpp
+    Created: 18 Oct 2026 11:02:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+CVPresetMatrix::CVPresetMatrix(CVGroup* group) :
+	group(group),
+	isDirty(true),
+	numPresets(0),
+	numColumns(0)
+{
+}
+
+CVPresetMatrix::~CVPresetMatrix()
+{
+}
+
+void CVPresetMatrix::setDirty()
+{
+	GenericScopedLock lock(matrixLock);
+	isDirty = true;
+}
+
+void CVPresetMatrix::rebuild()
+{
+	GenericScopedLock lock(matrixLock);
+
+	valueInfos.clearQuick();
+	valueIndexMap.clear();
+	numColumns = 0;
+
+	for (auto& item : group->values.items)
+	{
+		Parameter* p = dynamic_cast<Parameter*>(item->controllable);
+		if (p == nullptr) continue;
+
+		ValueInfo vi;
+		vi.parameter = p;
+		vi.type = p->type;
+		vi.firstColumn = numColumns;
+		vi.numColumns = getNumComponents(p);
+		vi.isComplete = true;
+
+		valueIndexMap.set(p, valueInfos.size());
+		valueInfos.add(vi);
+		numColumns += vi.numColumns;
+	}
+
+	numPresets = group->pm->items.size();
+	data.calloc((size_t)jmax(numPresets * numColumns, 1));
+	result.calloc((size_t)jmax(numColumns, 1));
+
+	//one pass on each preset's links instead of a lookup per value
+	Array<int> numPresetsWithValue;
+	numPresetsWithValue.insertMultiple(0, 0, valueInfos.size());
+
+	for (int r = 0; r < numPresets; r++)
+	{
+		CVPreset* preset = group->pm->items[r];
+		HashMap<ParameterPreset*, Parameter*>::Iterator it(preset->values.linkMap);
+		while (it.next())
+		{
+			if (!valueIndexMap.contains(it.getValue())) continue;
+			int index = valueIndexMap[it.getValue()];
+			numPresetsWithValue.getReference(index)++;
+
+			const ValueInfo& vi = valueInfos.getReference(index);
+			if (vi.numColumns > 0) readComponents(it.getKey()->parameter->value, data + (size_t)r * numColumns + vi.firstColumn, vi.numColumns);
+		}
+	}
+
+	for (int i = 0; i < valueInfos.size(); i++) valueInfos.getReference(i).isComplete = numPresetsWithValue[i] == numPresets;
+
+	isDirty = false;
+}
+
+void CVPresetMatrix::presetValueChanged(CVPreset* preset, ParameterPreset* pp)
+{
+	GenericScopedLock lock(matrixLock);
+	if (isDirty) return; //will be read on rebuild
+
+	int r = group->pm->items.indexOf(preset);
+	Parameter* source = preset->values.linkMap[pp];
+	if (r < 0 || r >= numPresets || source == nullptr || !valueIndexMap.contains(source))
+	{
+		isDirty = true;
+		return;
+	}
+
+	const ValueInfo& vi = valueInfos.getReference(valueIndexMap[source]);
+	if (vi.numColumns > 0) readComponents(pp->parameter->value, data + (size_t)r * numColumns + vi.firstColumn, vi.numColumns);
+}
+
+void CVPresetMatrix::blend(const Array<float>& weights)
+{
+	GenericScopedLock lock(matrixLock);
+
+	if (isDirty || numPresets != group->pm->items.size()) rebuild();
+	if (weights.size() != numPresets) return;
+
+	if (numColumns > 0)
+	{
+		FloatVectorOperations::clear(result, numColumns);
+		for (int r = 0; r < numPresets; r++)
+		{
+			if (weights[r] == 0) continue;
+			FloatVectorOperations::addWithMultiply(result, data + (size_t)r * numColumns, weights[r], numColumns);
+		}
+	}
+
+	for (auto& vi : valueInfos)
+	{
+		if (!vi.isComplete) continue;
+
+		Parameter* p = vi.parameter.get();
+		if (p == nullptr || p->type != vi.type) continue;
+
+		if (vi.numColumns == 0)
+		{
+			Array<var> pValues;
+			for (auto& preset : group->pm->items)
+			{
+				if (ParameterPreset* pp = preset->values.getParameterPresetForSource(p)) pValues.add(pp->parameter->value);
+			}
+
+			if (pValues.size() == weights.size()) p->setWeightedValue(pValues, weights);
+			continue;
+		}
+
+		//compared to the current value and not the previous blend, the value may have been set elsewhere since
+		const float* values = result + vi.firstColumn;
+		float currentValues[4];
+		if (readComponents(p->value, currentValues, vi.numColumns) == vi.numColumns && memcmp(values, currentValues, vi.numColumns * sizeof(float)) == 0) continue;
+		setComponents(p, values, vi.numColumns);
+	}
+}
+
+int CVPresetMatrix::getNumComponents(Parameter* p)
+{
+	switch (p->type)
+	{
+	case Controllable::FLOAT:
+	case Controllable::INT:
+		return 1;
+
+	case Controllable::POINT2D: return 2;
+	case Controllable::POINT3D: return 3;
+	case Controllable::COLOR: return 4;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+int CVPresetMatrix::readComponents(const var& value, float* dest, int maxComponents)
+{
+	if (!value.isArray())
+	{
+		dest[0] = value;
+		return 1;
+	}
+
+	int num = jmin(value.size(), maxComponents);
+	for (int i = 0; i < num; i++) dest[i] = value[i];
+	return num;
+}
+
+void CVPresetMatrix::setComponents(Parameter* p, const float* components, int numComponents)
+{
+	switch (p->type)
+	{
+	case Controllable::FLOAT:
+	case Controllable::INT:
+		p->setValue(components[0]);
+		break;
+
+	case Controllable::POINT2D:
+		((Point2DParameter*)p)->setPoint(components[0], components[1]);
+		break;
+
+	case Controllable::POINT3D:
+		((Point3DParameter*)p)->setVector(components[0], components[1], components[2]);
+		break;
+
+	case Controllable::COLOR:
+		((ColorParameter*)p)->setColor(Colour::fromFloatRGBA(components[0], components[1], components[2], numComponents > 3 ? components[3] : 1));
+		break;
+
+	default:
+		break;
+	}
+}
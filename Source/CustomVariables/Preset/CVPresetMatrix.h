@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    CVPresetMatrix.h
+    Created: 18 Oct 2026 11:02:45pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class CVGroup;
+
+/*
+	Dense presets x columns matrix of the preset values of a group, a variable takes one column per component (float, int, point and color variables).
+	It is rebuilt when variables or presets are added, removed or reordered and a single cell is updated when a preset value is edited,
+	so blending the presets is one multiply-add per preset row over all the columns.
+	Variables that can't be blended by component (bool, enum, string...) are blended with Parameter::setWeightedValue as before.
+*/
+class CVPresetMatrix
+{
+public:
+	CVPresetMatrix(CVGroup* group);
+	~CVPresetMatrix();
+
+	struct ValueInfo
+	{
+		WeakReference<Parameter> parameter;
+		Controllable::Type type;
+		int firstColumn;
+		int numColumns; //0 if not blended by component
+		bool isComplete; //all presets have this value, incomplete values are not blended
+	};
+
+	CVGroup* group;
+
+	CriticalSection matrixLock;
+	bool isDirty;
+
+	Array<ValueInfo> valueInfos;
+	HashMap<Parameter*, int> valueIndexMap;
+
+	int numPresets;
+	int numColumns;
+	HeapBlock<float> data; //numPresets x numColumns
+	HeapBlock<float> result;
+
+	void setDirty();
+	void rebuild();
+	void presetValueChanged(CVPreset* preset, ParameterPreset* pp);
+
+	void blend(const Array<float>& weights);
+
+	static int getNumComponents(Parameter* p); //0 for values that are not blended by component
+	static int readComponents(const var& value, float* dest, int maxComponents = 4);
+	static void setComponents(Parameter* p, const float* components, int numComponents);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CVPresetMatrix)
+};
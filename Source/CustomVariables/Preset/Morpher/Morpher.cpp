@@ -8,15 +8,17 @@
   ==============================================================================
 */
 
+#include "Module/ModuleIncludes.h"
+
 #define JC_VORONOI_IMPLEMENTATION
 #include "jc_voronoi.h"
 
 Morpher::Morpher(CVPresetManager* presetManager) :
 	ControllableContainer("Morpher"),
-	Thread("Morpher"),
 	presetManager(presetManager),
     mainTarget("Main"),
     attractionSleepMS(20),
+	attractionLiveness(new EventScheduler::OwnerLiveness()),
 	blendMode(VORONOI)
 {
 
@@ -71,77 +73,139 @@ Morpher::~Morpher()
 	presetManager->removeBaseManagerListener(this);
 	presetManager->removeControllableContainerListener(this);
 
-	stopThread(100);
-	
-	if (diagram->internal != nullptr && diagram->internal->memctx != nullptr) jcv_diagram_free(diagram.get());
+	attractionLiveness->isAlive = false;
+	stopAttraction();
+	if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating())
+	{
+		scheduler->cancelAll(this, true, 100); //bounded, the values set by a running tick may wait for the message thread
+		scheduler->cancelAll(this, false); //a tick that was running may have scheduled the next one
+	}
+
+	if (diagram->internal != nullptr) jcv_diagram_free(diagram.get());
 }
 
 Array<Point<float>> Morpher::getNormalizedTargetPoints()
 {
 	Array<Point<float>> result;
-	for (CVPreset* mt : presetManager->items) if (mt->enabled->boolValue()) result.add(mt->viewUIPosition->getPoint());
+	for (CVPreset* mt : presetManager->items) if (mt->isBlendable()) result.add(mt->viewUIPosition->getPoint());
 	return result;
 }
 
 CVPreset* Morpher::getEnabledTargetAtIndex(int index)
 {
-	int i = 0;
-	for (auto& mt : presetManager->items)
-	{
-		if (!mt->enabled->boolValue()) continue;
-		if (i == index) return mt;
-		i++;
-	}
-	return nullptr;
+	return enabledTargets[index];
 }
 
+void Morpher::setBlendMode(BlendMode mode)
+{
+	if (blendMode == mode) return;
+	blendMode = mode;
+	computeZones();
+}
 
 void Morpher::computeZones()
 {
-	GenericScopedLock lock(voronoiLock);
+	{
+		GenericScopedLock lock(voronoiLock);
 
-	Array<Point<float>> points = getNormalizedTargetPoints();
+		enabledTargets.clearQuick();
+		targetPoints.clearQuick();
+		for (auto& mt : presetManager->items)
+		{
+			if (!mt->isBlendable()) continue;
+			enabledTargets.add(mt);
+			targetPoints.add(mt->viewUIPosition->getPoint());
+		}
 
-	if (points.size() == 0) return;
+		int numTargets = enabledTargets.size();
+		targetWeights.resize(numTargets);
 
-	Array<jcv_point> jPoints;
+		if (diagram->internal != nullptr) jcv_diagram_free(diagram.get());
+		memset(diagram.get(), 0, sizeof(jcv_diagram));
 
-	for (Point<float> p : points)
-	{
-		jcv_point jp;
-		jp.x = p.x;
-		jp.y = p.y;
-		jPoints.add(jp);
+		voronoiSites.clearQuick();
+		voronoiEdges.clearQuick();
+		edgeNeighbourPairs.clearQuick();
+		siteIndex.clear();
+		gradientVectors.clearQuick();
 
-	}
+		if (blendMode == VORONOI && numTargets > 0)
+		{
+			Array<jcv_point> jPoints;
+			for (Point<float> p : targetPoints)
+			{
+				jcv_point jp;
+				jp.x = p.x;
+				jp.y = p.y;
+				jPoints.add(jp);
+			}
 
-	if (diagram->internal != nullptr && diagram->internal->memctx != nullptr) jcv_diagram_free(diagram.get());
-	jcv_diagram_generate(points.size(), jPoints.getRawDataPointer() , nullptr, diagram.get());
+			jcv_diagram_generate(numTargets, jPoints.getRawDataPointer(), nullptr, diagram.get());
 
-	computeWeights();
-}
+			//flatten the sites, their edges and which neighbours are neighbours of each other
+			const jcv_site* sites = jcv_diagram_get_sites(diagram.get());
+			Array<Point<float>> sitePoints;
+			int maxEdges = 0;
 
-int Morpher::getSiteIndexForPoint(Point<float> p)
-{
-	if (diagram == nullptr) return -1;
+			for (int i = 0; i < diagram->numsites; ++i)
+			{
+				const jcv_site& s = sites[i];
 
-	if (diagram->numsites == 0) return -1;
-	const jcv_site* sites = jcv_diagram_get_sites(diagram.get());
+				VoronoiSite vs;
+				vs.position = Point<float>(s.p.x, s.p.y);
+				vs.target = s.index;
+				vs.firstEdge = voronoiEdges.size();
+				vs.firstPair = edgeNeighbourPairs.size();
 
-	float minDist = p.getDistanceFrom(Point<float>(sites[0].p.x, sites[0].p.y));
-	float index = 0;
-	for (int i = 1; i < diagram->numsites; ++i)
-	{
-		float dist = p.getDistanceFrom(Point<float>(sites[i].p.x, sites[i].p.y));
+				Array<jcv_site*> neighbours;
+				for (jcv_graphedge* edge = s.edges; edge != nullptr; edge = edge->next)
+				{
+					jcv_site* ns = edge->neighbor;
+					if (ns == nullptr) continue;
+
+					VoronoiEdge ve;
+					ve.line = Line<float>(Point<float>(edge->pos[0].x, edge->pos[0].y), Point<float>(edge->pos[1].x, edge->pos[1].y));
+					ve.neighbourPosition = Point<float>(ns->p.x, ns->p.y);
+					ve.neighbourTarget = ns->index;
+					voronoiEdges.add(ve);
+					neighbours.add(ns);
+				}
+
+				vs.numEdges = neighbours.size();
+				for (int e1 = 0; e1 < vs.numEdges; e1++)
+				{
+					for (int e2 = 0; e2 < vs.numEdges; e2++) edgeNeighbourPairs.add(e1 != e2 && checkSitesAreNeighbours(neighbours[e1], neighbours[e2]));
+				}
+
+				maxEdges = jmax(maxEdges, vs.numEdges);
+				voronoiSites.add(vs);
+				sitePoints.add(vs.position);
+			}
 
-		if (dist < minDist)
+			siteIndex.build(sitePoints);
+			edgeDists.resize(maxEdges);
+			edgeNeighbourDists.resize(maxEdges);
+		}
+		else if (blendMode == GRADIENT_BAND)
 		{
-			minDist = dist;
-			index = i;
+			for (int i = 0; i < numTargets; i++)
+			{
+				for (int j = 0; j < numTargets; j++)
+				{
+					Point<float> d = targetPoints[j] - targetPoints[i];
+					float sqLength = d.getDistanceSquaredFromOrigin();
+					gradientVectors.add(i == j || sqLength == 0 ? Point<float>() : d / sqLength);
+				}
+			}
 		}
 	}
 
-	return index;
+	computeWeights();
+}
+
+int Morpher::getSiteIndexForPoint(Point<float> p)
+{
+	return siteIndex.getNearest(p);
 }
 
 
@@ -149,148 +213,124 @@ void Morpher::computeWeights()
 {
 	if (!voronoiLock.tryEnter()) return;
 
+	Point<float> mp = mainTarget.viewUIPosition->getPoint();
+
+	bool hasWeights = false;
 	switch (blendMode)
 	{
-	case VORONOI:
-	{
-		if (diagram->numsites <= 1) break;
-		for (CVPreset* mt : presetManager->items) mt->weight->setValue(0);
-
-		HashMap<CVPreset*, float> rawWeights;
-		float totalRawWeight = 0;
+	case VORONOI: hasWeights = computeVoronoiWeights(mp); break;
+	case GRADIENT_BAND: hasWeights = computeGradientBandWeights(mp); break;
+	default: break;
+	}
 
-		Point<float> mp = mainTarget.viewUIPosition->getPoint();
+	if (hasWeights)
+	{
+		for (CVPreset* mt : presetManager->items) if (!mt->isBlendable()) mt->weight->setValue(0);
+		for (int i = 0; i < enabledTargets.size(); i++) enabledTargets[i]->weight->setValue(targetWeights[i]);
+	}
 
-		int index = getSiteIndexForPoint(mp);
-		if (index == -1) break;
+	voronoiLock.exit();
 
-		const jcv_site* sites = jcv_diagram_get_sites(diagram.get());
+	morpherListeners.call(&MorpherListener::weightsUpdated);
+}
 
-		jcv_site s = sites[index];
+bool Morpher::computeVoronoiWeights(Point<float> mp)
+{
+	if (voronoiSites.size() <= 1) return false;
 
-		//curZoneIndex->setValue(getSiteIndexForPoint(mp));
+	int index = getSiteIndexForPoint(mp);
+	if (index == -1) return false;
 
-		//Compute direct site
-		CVPreset* mt = getEnabledTargetAtIndex(s.index);
-		float d = mp.getDistanceFrom(Point<float>(s.p.x, s.p.y));
+	const VoronoiSite& s = voronoiSites.getReference(index);
 
-		float mw = (float)INT32_MAX;
-		if (d != 0) mw = 1.0f / d;
-		rawWeights.set(mt, mw);
-		totalRawWeight += mw;
+	FloatVectorOperations::clear(targetWeights.getRawDataPointer(), targetWeights.size());
+	float totalRawWeight = 0;
 
+	//Compute direct site
+	float d = mp.getDistanceFrom(s.position);
+	float mw = (float)INT32_MAX;
+	if (d != 0) mw = 1.0f / d;
+	targetWeights.set(s.target, mw);
+	totalRawWeight += mw;
 
+	//Fill edge distances
+	const VoronoiEdge* edges = voronoiEdges.begin() + s.firstEdge;
+	const bool* neighbourPairs = edgeNeighbourPairs.begin() + s.firstPair;
 
-		//Fill edge distances
+	for (int i = 0; i < s.numEdges; ++i)
+	{
+		Point<float> np;
+		edgeDists.set(i, edges[i].line.getDistanceFromPoint(mp, np));
+		edgeNeighbourDists.set(i, np.getDistanceFrom(edges[i].neighbourPosition));
+	}
 
-		jcv_graphedge* edge = s.edges;
-		Array<jcv_graphedge*> edges;
+	//Compute weight for each neighbour
+	for (int i = 0; i < s.numEdges; ++i)
+	{
+		float edgeDist = edgeDists[i];
+		float totalDist = edgeDist + edgeNeighbourDists[i];
 
-		Array<float> edgeDists;
-		Array<float> edgeNeighbourDists;
-		Array<jcv_site*> neighbourSites;
-		Array<Line<float>> edgeLines;
+		float minOtherEdgeDist = (float)INT32_MAX;
+		bool hasOtherEdge = false;
 
-		while (edge != nullptr)
+		for (int j = 0; j < s.numEdges; j++)
 		{
-			jcv_site* ns = edge->neighbor;// e->sites[0]->index == s.index ? e->sites[1] : e->sites[0];
+			if (i == j || neighbourPairs[i * s.numEdges + j]) continue;
 
-			if (ns == nullptr)
+			if (edgeDists[j] < minOtherEdgeDist)
 			{
-				edge = edge->next;
-				continue;
+				minOtherEdgeDist = edgeDists[j];
+				hasOtherEdge = true;
 			}
-
-			//DBG("Site " << s.index << " : Edge has sites " << e->sites[0]->index << "and " << e->sites[1]->index << ", chosen " << ns->index);
-			//DBG("\t\t" << edge->pos[0].x << " / " << edge->pos[0].y << " / " << edge->pos[1].x << " / " << edge->pos[1].y);
-
-			Line<float> line(Point<float>(edge->pos[0].x, edge->pos[0].y), Point<float>(edge->pos[1].x, edge->pos[1].y));
-			Point<float> np;
-			float distToEdge = line.getDistanceFromPoint(mp, np);
-			float distNeighbourToEdge = np.getDistanceFrom(Point<float>(ns->p.x, ns->p.y));
-
-			edges.add(edge);
-
-			edgeDists.add(distToEdge);
-			edgeNeighbourDists.add(distNeighbourToEdge);
-			neighbourSites.add(ns);
-			edgeLines.add(line);
-
-			edge = edge->next;
 		}
 
-		//DBG("Num edges to test " << edges.size());
-
-		//Compute weight for each neighbour
-		for (int i = 0; i < edges.size(); ++i)
+		float w = 0;
+		if (hasOtherEdge)
 		{
-			float edgeDist = edgeDists[i];
-			float edgeNDist = edgeNeighbourDists[i];
-			float totalDist = edgeDist + edgeNDist;
-
-
-			float minOtherEdgeDist = (float)INT32_MAX;
-			jcv_graphedge* minEdge = nullptr;
-
-			for (int j = 0; j < edges.size(); j++)
-			{
-				if (i == j) continue;
-
-				if (checkSitesAreNeighbours(edges[i]->neighbor, edges[j]->neighbor)) continue;
-
-				float ed = edgeDists[j];
-				if (ed < minOtherEdgeDist)
-				{
-					minOtherEdgeDist = ed;
-					minEdge = edges[j];
-				}
-			}
-
-
-			float w = 0;
-			if (minEdge != nullptr)
-			{
-				float ratio = 1 - (edgeDist / (edgeDist + minOtherEdgeDist));
-				w = ratio / totalDist;
-			}
-			else
-			{
-				float directDist = mp.getDistanceFrom(Point<float>(neighbourSites[i]->p.x, neighbourSites[i]->p.y)); //if we want to check direct distance instead of path to point
-				w = 1.0f / directDist;
-			}
-
-			CVPreset* nmt = getEnabledTargetAtIndex(neighbourSites[i]->index);
-			rawWeights.set(nmt, w);
-			totalRawWeight += w;
+			float ratio = 1 - (edgeDist / (edgeDist + minOtherEdgeDist));
+			w = ratio / totalDist;
 		}
-
-		//DBG("Cur site " << s.index << " : " << mt->niceName << ": " << mw << ", total =  " << totalRawWeight << ", numWeighted neighbours " << rawWeights.size());
-
-
-		//Normalize weights
-		for (HashMap<CVPreset*, float>::Iterator i(rawWeights); i.next();)
+		else
 		{
-			float val = i.getValue() / totalRawWeight;
-			i.getKey()->weight->setValue(val);
-
+			w = 1.0f / mp.getDistanceFrom(edges[i].neighbourPosition); //if we want to check direct distance instead of path to point
 		}
 
+		targetWeights.set(edges[i].neighbourTarget, w);
+		totalRawWeight += w;
 	}
-	break;
 
+	//Normalize weights
+	FloatVectorOperations::multiply(targetWeights.getRawDataPointer(), 1.0f / totalRawWeight, targetWeights.size());
+	return true;
+}
 
+bool Morpher::computeGradientBandWeights(Point<float> mp)
+{
+	int numTargets = enabledTargets.size();
+	if (numTargets == 0) return false;
 
-	case GRADIENT_BAND:
-		//Not implemented yet
-		break;
+	//Each target's influence is 1 at its position and fades to 0 towards every other target
+	float totalWeight = 0;
+	for (int i = 0; i < numTargets; i++)
+	{
+		Point<float> rel = mp - targetPoints[i];
+		const Point<float>* vectors = gradientVectors.begin() + i * numTargets;
 
-	default:
-		break;
+		float w = 1;
+		for (int j = 0; j < numTargets && w > 0; j++)
+		{
+			if (i != j) w = jmin(w, 1 - rel.getDotProduct(vectors[j]));
+		}
+
+		w = jmax(w, 0.f);
+		targetWeights.set(i, w);
+		totalWeight += w;
 	}
 
-	voronoiLock.exit();
+	if (totalWeight <= 0) return false;
 
-	morpherListeners.call(&MorpherListener::weightsUpdated);
+	FloatVectorOperations::multiply(targetWeights.getRawDataPointer(), 1.0f / totalWeight, numTargets);
+	return true;
 }
 
 bool Morpher::checkSitesAreNeighbours(jcv_site* s1, jcv_site* s2)
@@ -313,7 +353,7 @@ void Morpher::itemAdded(CVPreset* cvp)
 
 void Morpher::itemRemoved(CVPreset* cvp)
 {
-	cvp->addControllableContainerListener(this);
+	cvp->removeControllableContainerListener(this);
 	computeZones();
 }
 
@@ -333,11 +373,8 @@ void Morpher::onContainerParameterChanged(Parameter* p)
 		attractionSpeed->setEnabled(useAttraction->boolValue());
 		attractionMode->setEnabled(useAttraction->boolValue());
 		attractionDecay->setEnabled(useAttraction->boolValue());
-		if (useAttraction->boolValue()) startThread();
-		else
-		{
-			stopThread(100);
-		}
+		if (useAttraction->boolValue()) startAttraction();
+		else stopAttraction();
 	}
 }
 
@@ -353,35 +390,57 @@ void Morpher::onControllableFeedbackUpdate(ControllableContainer*, Controllable*
 	}
 }
 
-void Morpher::run()
+void Morpher::startAttraction()
 {
-	while (!threadShouldExit())
-	{
-		float timeFactor = attractionSleepMS / 1000.0f;
+	int generation = ++attractionGeneration;
+	scheduleAttraction(Time::getMillisecondCounterHiRes(), generation);
+}
 
-		attractionDir.setXY(0, 0);
-		Point<float> mp = mainTarget.viewUIPosition->getPoint();
-		int num = 0;
-		for (auto& t : presetManager->items)
+void Morpher::scheduleAttraction(double time, int generation)
+{
+	EventScheduler::OwnerLiveness::Ptr liveness = attractionLiveness;
+	ContinuousProcessScheduler::getInstance()->scheduleAt(time, [this, generation, liveness]()
 		{
-			if (!t->enabled->boolValue()) continue;
-			attractionDir += (t->viewUIPosition->getPoint() - mp) * t->attraction->floatValue();
-			t->attraction->setValue(t->attraction->floatValue() - attractionDecay->floatValue() * timeFactor);
-			num++;
-		}
+			if (liveness->isAlive) processAttraction(generation, liveness);
+		}, this);
+}
 
-		AttractionMode am = attractionMode->getValueDataAsEnum<AttractionMode>();
-		switch (am)
-		{
-		case SIMPLE:
-			mainTarget.viewUIPosition->setPoint(mp + attractionDir * timeFactor * attractionSpeed->floatValue());
-			break;
+void Morpher::stopAttraction()
+{
+	++attractionGeneration;
+	if (ContinuousProcessScheduler* scheduler = ContinuousProcessScheduler::getInstanceWithoutCreating()) scheduler->cancelAll(this, false);
+}
 
-		case PHYSICS:
-			break;
-		}
+void Morpher::processAttraction(int generation, EventScheduler::OwnerLiveness::Ptr liveness)
+{
+	if (generation != attractionGeneration.get()) return;
 
-		computeWeights();
-		wait(attractionSleepMS);
+	double time = Time::getMillisecondCounterHiRes();
+	float timeFactor = attractionSleepMS / 1000.0f;
+
+	attractionDir.setXY(0, 0);
+	Point<float> mp = mainTarget.viewUIPosition->getPoint();
+	for (auto& t : presetManager->items)
+	{
+		if (!t->isBlendable()) continue;
+		attractionDir += (t->viewUIPosition->getPoint() - mp) * t->attraction->floatValue();
+		t->attraction->setValue(t->attraction->floatValue() - attractionDecay->floatValue() * timeFactor);
+	}
+
+	AttractionMode am = attractionMode->getValueDataAsEnum<AttractionMode>();
+	switch (am)
+	{
+	case SIMPLE:
+		mainTarget.viewUIPosition->setPoint(mp + attractionDir * timeFactor * attractionSpeed->floatValue());
+		break;
+
+	case PHYSICS:
+		break;
 	}
+
+	if (!liveness->isAlive) return; //deleted while moving the target
+	computeWeights();
+
+	if (!liveness->isAlive || generation != attractionGeneration.get()) return;
+	scheduleAttraction(time + attractionSleepMS, generation);
 }
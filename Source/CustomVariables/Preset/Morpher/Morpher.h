@@ -13,8 +13,7 @@
 
 class Morpher :
 	public ControllableContainer,
-	public CVPresetManager::ManagerListener,
-	public Thread
+	public CVPresetManager::ManagerListener
 {
 public:
 
@@ -40,6 +39,8 @@ public:
 
 	Point<float> attractionDir;
 	int attractionSleepMS;
+	Atomic<int> attractionGeneration;
+	EventScheduler::OwnerLiveness::Ptr attractionLiveness; //dead once the morpher is being deleted
 
 	enum BlendMode { VORONOI, GRADIENT_BAND };
 	BlendMode blendMode;
@@ -55,11 +56,46 @@ public:
 
 	SpinLock voronoiLock;
 
+	//Cached on computeZones so computing the weights of a moving target doesn't allocate
+	Array<CVPreset*> enabledTargets;
+	Array<Point<float>> targetPoints;
+	Array<float> targetWeights;
+
+	struct VoronoiSite
+	{
+		Point<float> position;
+		int target; //index in enabledTargets
+		int firstEdge;
+		int numEdges;
+		int firstPair; //numEdges x numEdges flags in edgeNeighbourPairs, true if the neighbours of both edges are neighbours
+	};
+
+	struct VoronoiEdge
+	{
+		Line<float> line;
+		Point<float> neighbourPosition;
+		int neighbourTarget;
+	};
+
+	Array<VoronoiSite> voronoiSites; //same order as the diagram sites
+	Array<VoronoiEdge> voronoiEdges;
+	Array<bool> edgeNeighbourPairs;
+	MorpherSiteIndex siteIndex;
+	Array<float> edgeDists;
+	Array<float> edgeNeighbourDists;
+
+	//Gradient band, (pj - pi) / |pj - pi|^2 for each pair of targets
+	Array<Point<float>> gradientVectors;
+
+	void setBlendMode(BlendMode mode);
+
 	//Voronoi
 	void computeZones();
 	int getSiteIndexForPoint(Point<float> p);
 
 	void computeWeights();
+	bool computeVoronoiWeights(Point<float> mp);
+	bool computeGradientBandWeights(Point<float> mp);
 
 	bool checkSitesAreNeighbours(jcv_site * s1, jcv_site * s2);
 
@@ -69,7 +105,10 @@ public:
 	void itemAdded(CVPreset *) override;
 	void itemRemoved(CVPreset*) override;
 
-	void run() override;
+	void startAttraction();
+	void stopAttraction();
+	void scheduleAttraction(double time, int generation);
+	void processAttraction(int generation, EventScheduler::OwnerLiveness::Ptr liveness);
 
 	class MorpherListener
 	{
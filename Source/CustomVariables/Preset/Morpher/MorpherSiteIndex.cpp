@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    MorpherSiteIndex.cpp
+    Created: 18 Oct 2026 11:48:20pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+MorpherSiteIndex::MorpherSiteIndex() :
+	gridSize(0),
+	cellWidth(1),
+	cellHeight(1)
+{
+}
+
+MorpherSiteIndex::~MorpherSiteIndex()
+{
+}
+
+void MorpherSiteIndex::clear()
+{
+	points.clearQuick();
+	cellStart.clearQuick();
+	cellItems.clearQuick();
+	gridSize = 0;
+}
+
+void MorpherSiteIndex::build(const Array<Point<float>>& sitePoints)
+{
+	clear();
+	if (sitePoints.isEmpty()) return;
+
+	points = sitePoints;
+	bounds = Rectangle<float>::findAreaContainingPoints(points.getRawDataPointer(), points.size());
+
+	gridSize = jmax(1, (int)std::ceil(std::sqrt((float)points.size())));
+	cellWidth = jmax(bounds.getWidth(), .0001f) / gridSize;
+	cellHeight = jmax(bounds.getHeight(), .0001f) / gridSize;
+
+	//counting sort of the sites by cell
+	int numCells = gridSize * gridSize;
+	cellStart.insertMultiple(0, 0, numCells + 1);
+
+	Array<int> siteCells;
+	for (auto& p : points)
+	{
+		int cell = getCellY(p.y) * gridSize + getCellX(p.x);
+		siteCells.add(cell);
+		cellStart.getReference(cell + 1)++;
+	}
+
+	for (int i = 0; i < numCells; i++) cellStart.getReference(i + 1) += cellStart[i];
+
+	Array<int> cellFill(cellStart.getRawDataPointer(), numCells);
+	cellItems.insertMultiple(0, 0, points.size());
+	for (int i = 0; i < points.size(); i++) cellItems.set(cellFill.getReference(siteCells[i])++, i);
+}
+
+int MorpherSiteIndex::getNearest(Point<float> p) const
+{
+	if (gridSize == 0) return -1;
+
+	int cx = getCellX(p.x);
+	int cy = getCellY(p.y);
+
+	int nearest = -1;
+	float minDist = std::numeric_limits<float>::max();
+
+	for (int r = 0; r < gridSize; r++)
+	{
+		int minX = cx - r;
+		int maxX = cx + r;
+		int minY = cy - r;
+		int maxY = cy + r;
+
+		for (int y = jmax(minY, 0); y <= jmin(maxY, gridSize - 1); y++)
+		{
+			for (int x = jmax(minX, 0); x <= jmin(maxX, gridSize - 1); x++)
+			{
+				if (x != minX && x != maxX && y != minY && y != maxY) continue; //inner cells were searched in previous rings
+
+				int cell = y * gridSize + x;
+				for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+				{
+					int index = cellItems[i];
+					float dist = p.getDistanceSquaredFrom(points.getReference(index));
+					if (dist < minDist || (dist == minDist && index < nearest))
+					{
+						minDist = dist;
+						nearest = index;
+					}
+				}
+			}
+		}
+
+		if (nearest == -1) continue;
+
+		//any site in the next rings is at least as far as the closest inner side of this ring
+		float bound = std::numeric_limits<float>::max();
+		if (minX > 0) bound = jmin(bound, p.x - (bounds.getX() + minX * cellWidth));
+		if (maxX < gridSize - 1) bound = jmin(bound, bounds.getX() + (maxX + 1) * cellWidth - p.x);
+		if (minY > 0) bound = jmin(bound, p.y - (bounds.getY() + minY * cellHeight));
+		if (maxY < gridSize - 1) bound = jmin(bound, bounds.getY() + (maxY + 1) * cellHeight - p.y);
+
+		if (bound == std::numeric_limits<float>::max()) break; //whole grid searched
+		if (bound > 0 && bound * bound >= minDist) break;
+	}
+
+	return nearest;
+}
+
+int MorpherSiteIndex::getCellX(float x) const
+{
+	return jlimit(0, gridSize - 1, (int)std::floor((x - bounds.getX()) / cellWidth));
+}
+
+int MorpherSiteIndex::getCellY(float y) const
+{
+	return jlimit(0, gridSize - 1, (int)std::floor((y - bounds.getY()) / cellHeight));
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    MorpherSiteIndex.h
+    Created: 18 Oct 2026 11:48:20pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Uniform grid over the sites of the morpher, about one site per cell.
+	Nearest site search only looks at the cells around the point, ring by ring, until no closer site can be found.
+*/
+class MorpherSiteIndex
+{
+public:
+	MorpherSiteIndex();
+	~MorpherSiteIndex();
+
+	Array<Point<float>> points;
+	Rectangle<float> bounds;
+	int gridSize;
+	float cellWidth;
+	float cellHeight;
+
+	Array<int> cellStart; //gridSize * gridSize + 1 offsets in cellItems
+	Array<int> cellItems;
+
+	void clear();
+	void build(const Array<Point<float>>& sitePoints);
+
+	int getNearest(Point<float> p) const;
+
+private:
+	int getCellX(float x) const;
+	int getCellY(float y) const;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorpherSiteIndex)
+};
@@ -176,7 +176,7 @@ void MorpherViewUI::paintBackground(Graphics& g)
 
 	case Morpher::VORONOI:
 	{
-		if (morpher->diagram == nullptr || manager->items.size() == 0) break;
+		if (morpher->diagram == nullptr || morpher->diagram->numsites == 0) break;
 
 		const jcv_site* sites = jcv_diagram_get_sites(morpher->diagram.get());
 		for (int i = 0; i < morpher->diagram->numsites; ++i)
@@ -66,6 +66,9 @@ public:
 	//ROUTING
 	bool canHandleRouteValues;
 
+	//Outputs of this module are sent at the current EventTimestamp instead of right away, so they can be processed ahead of time
+	virtual bool canScheduleOutput() { return false; }
+
 	//help
     virtual String getHelpID() override;
 
@@ -43,6 +43,7 @@
 #include "Routing/ui/ModuleRouterValueEditor.cpp"
 #include "Routing/ui/ModuleRouterView.cpp"
 #include "modules/audio/AudioModule.cpp"
+#include "modules/audio/AudioCuePlayer.cpp"
 #include "modules/audio/analysis/FFTAnalyzer.cpp"
 #include "modules/audio/analysis/FFTAnalyzerManager.cpp"
 #include "modules/audio/analysis/ui/FFTAnalyzerEditor.cpp"
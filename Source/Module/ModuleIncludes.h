@@ -38,6 +38,7 @@
 #include "modules/audio/analysis/FFTAnalyzer.h"
 #include "modules/audio/analysis/FFTAnalyzerManager.h"
 
+#include "modules/audio/AudioCuePlayer.h"
 #include "modules/audio/AudioModule.h"
 
 #include "modules/audio/analysis/ui/FFTAnalyzerEditor.h"
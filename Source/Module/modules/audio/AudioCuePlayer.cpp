@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    AudioCuePlayer.cpp
+    Created: 18 Oct 2026 9:04:33pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+AudioCuePlayer::AudioCuePlayer(AudioModule* module) :
+	module(module),
+	voiceCounter(0),
+	currentSampleRate(44100)
+{
+}
+
+AudioCuePlayer::~AudioCuePlayer()
+{
+	cancelPendingUpdate();
+}
+
+void AudioCuePlayer::play(AudioCue* cue, const Array<int>& outChannels, float gain)
+{
+	if (cue == nullptr || cue->buffer.getNumSamples() == 0) return;
+
+	uint64 mask = 0;
+	for (auto& c : outChannels) if (c >= 0 && c < 64) mask |= (uint64)1 << c;
+	if (mask == 0) return;
+
+	GenericScopedLock<SpinLock> lock(voiceLock);
+
+	Voice* voice = &voices[0];
+	for (auto& v : voices)
+	{
+		if (!v.isActive)
+		{
+			voice = &v;
+			break;
+		}
+		if (v.startOrder < voice->startOrder) voice = &v;
+	}
+
+	voice->cue = cue;
+	voice->position = 0;
+	voice->increment = cue->sampleRate / currentSampleRate;
+	voice->channelMask = mask;
+	voice->gain = gain;
+	voice->startOrder = ++voiceCounter;
+	voice->isActive = true;
+}
+
+void AudioCuePlayer::stopAll()
+{
+	{
+		GenericScopedLock<SpinLock> lock(voiceLock);
+		for (auto& v : voices) v.isActive = false;
+	}
+
+	triggerAsyncUpdate();
+}
+
+void AudioCuePlayer::clear()
+{
+	GenericScopedLock<SpinLock> lock(voiceLock);
+	for (auto& v : voices)
+	{
+		v.isActive = false;
+		v.cue = nullptr;
+	}
+}
+
+void AudioCuePlayer::handleAsyncUpdate()
+{
+	ReferenceCountedArray<AudioCue> finishedCues;
+	{
+		GenericScopedLock<SpinLock> lock(voiceLock);
+		for (auto& v : voices)
+		{
+			if (v.isActive || v.cue == nullptr) continue;
+			finishedCues.add(v.cue);
+			v.cue = nullptr;
+		}
+	}
+
+	if (finishedCues.isEmpty()) return;
+
+	//cues are only freed once no command nor voice uses them
+	finishedCues.clear();
+	if (AudioStreamManager* sm = AudioStreamManager::getInstanceWithoutCreating()) sm->releaseUnusedCues();
+}
+
+void AudioCuePlayer::prepareToPlay(double sampleRate, int)
+{
+	if (sampleRate > 0) currentSampleRate = sampleRate;
+}
+
+void AudioCuePlayer::processBlock(AudioBuffer<float>& buffer, MidiBuffer&)
+{
+	buffer.clear();
+
+	float volume = module != nullptr ? module->outVolume->floatValue() : 1;
+	int numSamples = buffer.getNumSamples();
+
+	bool hasFinishedVoices = false;
+	GenericScopedLock<SpinLock> lock(voiceLock);
+
+	for (auto& v : voices)
+	{
+		if (!v.isActive) continue;
+
+		const AudioBuffer<float>& source = v.cue->buffer;
+		int sourceLength = source.getNumSamples();
+		int numSourceChannels = source.getNumChannels();
+		float gain = v.gain * volume;
+
+		//each selected output takes the next channel of the cue, mono cues go to all selected outputs
+		int sourceChannel = 0;
+		for (int c = 0; c < buffer.getNumChannels() && c < 64; ++c)
+		{
+			if ((v.channelMask & ((uint64)1 << c)) == 0) continue;
+
+			const float* src = source.getReadPointer(sourceChannel % numSourceChannels);
+			float* dest = buffer.getWritePointer(c);
+			sourceChannel++;
+
+			if (v.increment == 1)
+			{
+				int start = (int)v.position;
+				int num = jmin(numSamples, sourceLength - start);
+				if (num > 0) FloatVectorOperations::addWithMultiply(dest, src + start, gain, num);
+			}
+			else
+			{
+				//linear interpolation when the cue and the device sample rates differ
+				double pos = v.position;
+				for (int i = 0; i < numSamples; ++i, pos += v.increment)
+				{
+					int index = (int)pos;
+					if (index >= sourceLength - 1) break;
+					float alpha = (float)(pos - index);
+					dest[i] += (src[index] + (src[index + 1] - src[index]) * alpha) * gain;
+				}
+			}
+		}
+
+		v.position += v.increment * numSamples;
+		if (v.position >= (v.increment == 1 ? sourceLength : sourceLength - 1))
+		{
+			v.isActive = false;
+			hasFinishedVoices = true;
+		}
+	}
+
+	if (hasFinishedVoices) triggerAsyncUpdate();
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    AudioCuePlayer.h
+    Created: 18 Oct 2026 9:04:33pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define AUDIO_CUE_MAX_VOICES 64
+
+class AudioModule;
+
+/*
+	Polyphonic player for in-memory cues, one node of the module's graph mixing all the voices.
+	A new voice starts at the next audio block, when all voices are used the oldest one is replaced.
+	Finished voices keep their cue until the message thread releases it, so a cue is never freed in the audio callback.
+*/
+class AudioCuePlayer :
+	public AudioProcessor,
+	public AsyncUpdater
+{
+public:
+	AudioCuePlayer(AudioModule* module);
+	~AudioCuePlayer();
+
+	AudioModule* module;
+
+	struct Voice
+	{
+		AudioCue::Ptr cue; //only replaced on the message thread, the audio thread only reads it
+		double position = 0;
+		double increment = 1;
+		uint64 channelMask = 0;
+		float gain = 1;
+		uint32 startOrder = 0;
+		bool isActive = false;
+	};
+
+	Voice voices[AUDIO_CUE_MAX_VOICES];
+	SpinLock voiceLock;
+	uint32 voiceCounter;
+	double currentSampleRate;
+
+	void play(AudioCue* cue, const Array<int>& outChannels, float gain = 1);
+	void stopAll();
+	void clear();
+
+	void handleAsyncUpdate() override;
+
+	virtual const String getName() const override { return "Cue Player"; }
+	virtual void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock) override;
+	virtual void releaseResources() override {}
+	virtual void processBlock(AudioBuffer<float>& buffer, MidiBuffer& midiMessages) override;
+	virtual double getTailLengthSeconds() const override { return 0; }
+	virtual bool acceptsMidi() const override { return false; }
+	virtual bool producesMidi() const override { return false; }
+	virtual AudioProcessorEditor* createEditor() override { return nullptr; }
+	virtual bool hasEditor() const override { return false; }
+	virtual int getNumPrograms() override { return 0; }
+	virtual int getCurrentProgram() override { return 0; }
+	virtual void setCurrentProgram(int) override {}
+	virtual const String getProgramName(int) override { return String(); }
+	virtual void changeProgramName(int, const String&) override {}
+	virtual void getStateInformation(juce::MemoryBlock&) override {}
+	virtual void setStateInformation(const void*, int) override {}
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioCuePlayer)
+};
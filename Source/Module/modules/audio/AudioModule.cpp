@@ -17,7 +17,8 @@ AudioModule::AudioModule(const String & name) :
     numActiveMonitorOutputs(0),
 	noteCC("Pitch Detection"),
 	fftCC("FFT Enveloppes"),
-	pitchDetector(nullptr)
+	pitchDetector(nullptr),
+	cuePlayer(nullptr)
 {
 	setupIOConfiguration(true, true);
 
@@ -26,6 +27,7 @@ AudioModule::AudioModule(const String & name) :
 	keepLastDetectedValues = moduleParams.addBoolParameter("Keep Values", "Keep last detected values when no activity detected.", false);
     
     outVolume = moduleParams.addFloatParameter("Out Volume","Global volume multiplier for all sound that is played through this module",1,0,10);
+	readAheadSize = moduleParams.addIntParameter("Read-Ahead Buffer", "Number of samples decoded in advance on a background thread for audio files played through this module. Bigger values avoid dropouts with long compressed files or slow disks, 0 decodes in the audio thread", 32768, 0, 1048576);
 	pitchDetectionMethod = moduleParams.addEnumParameter("Pitch Detection Method", "Choose how to detect the pitch.\nNone will disable the detection (for performance),\nMPM is better suited for monophonic sounds,\nYIN is better suited for high-pitched voices and music");
 	pitchDetectionMethod->addOption("None", NONE)->addOption("MPM", MPM)->addOption("YIN", YIN);
 
@@ -77,6 +79,11 @@ AudioModule::AudioModule(const String & name) :
 	std::unique_ptr<AudioProcessorGraph::AudioGraphIOProcessor> procOut(new AudioProcessorGraph::AudioGraphIOProcessor(AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
 	graph.addNode(std::move(procIn), AudioProcessorGraph::NodeID(1));
 	graph.addNode(std::move(procOut), AudioProcessorGraph::NodeID(2));
+
+	std::unique_ptr<AudioCuePlayer> procCues(new AudioCuePlayer(this));
+	cuePlayer = procCues.get();
+	graph.addNode(std::move(procCues), AudioProcessorGraph::NodeID(AUDIO_CUE_GRAPH_ID));
+	updateCuePlayer();
 	
 	player.setProcessor(&graph);
 
@@ -92,6 +99,7 @@ AudioModule::AudioModule(const String & name) :
 
 AudioModule::~AudioModule()
 {
+	cuePlayer = nullptr;
 	graph.clear();
 
 	am.removeAudioCallback(&player);
@@ -115,6 +123,28 @@ void AudioModule::updateSelectedMonitorChannels()
 	numActiveMonitorOutputs = selectedMonitorOutChannels.size();
 }
 
+void AudioModule::updateCuePlayer()
+{
+	if (cuePlayer == nullptr) return;
+
+	graph.disconnectNode(AudioProcessorGraph::NodeID(AUDIO_CUE_GRAPH_ID));
+
+	int numChannels = graph.getMainBusNumOutputChannels();
+	cuePlayer->setPlayConfigDetails(0, numChannels, currentSampleRate, currentBufferSize);
+	cuePlayer->prepareToPlay(currentSampleRate, currentBufferSize);
+
+	for (int i = 0; i < numChannels; ++i)
+	{
+		graph.addConnection({ {AudioProcessorGraph::NodeID(AUDIO_CUE_GRAPH_ID), i }, {AudioProcessorGraph::NodeID(AUDIO_OUTPUT_GRAPH_ID), i } });
+	}
+}
+
+void AudioModule::playCue(AudioCue* cue, const Array<int>& outChannels, float gain)
+{
+	if (cuePlayer == nullptr || !enabled->boolValue()) return;
+	cuePlayer->play(cue, outChannels, gain);
+}
+
 void AudioModule::onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c)
 {
 	Module::onControllableFeedbackUpdateInternal(cc, c);
@@ -148,6 +178,10 @@ void AudioModule::onContainerParameterChangedInternal(Parameter * p)
 		if (enabled->boolValue()) player.setProcessor(&graph);
 		else player.setProcessor(nullptr);
 	}
+	else if (p == readAheadSize)
+	{
+		audioModuleListeners.call(&AudioModuleListener::streamSetupChanged);
+	}
 }
 
 var AudioModule::getJSONData()
@@ -282,6 +316,7 @@ void AudioModule::changeListenerCallback(ChangeBroadcaster *)
 	}
 
 	updateSelectedMonitorChannels();
+	updateCuePlayer();
     
     audioModuleListeners.call(&AudioModuleListener::audioSetupChanged);
 	audioModuleListeners.call(&AudioModuleListener::monitorSetupChanged);
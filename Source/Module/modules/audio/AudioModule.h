@@ -12,6 +12,7 @@
 
 #define AUDIO_INPUT_GRAPH_ID 1
 #define AUDIO_OUTPUT_GRAPH_ID 2
+#define AUDIO_CUE_GRAPH_ID 3
 
 
 class AudioModuleHardwareSettings :
@@ -39,6 +40,7 @@ public:
 	AudioDeviceManager am;
 	AudioProcessorPlayer player;
 	AudioProcessorGraph graph;
+	AudioCuePlayer* cuePlayer;
 	
 	double currentSampleRate;
 	int currentBufferSize;
@@ -55,6 +57,7 @@ public:
 	FloatParameter * inputGain;
 	FloatParameter * activityThreshold;
     FloatParameter * outVolume;
+	IntParameter * readAheadSize;
 
 	ControllableContainer monitorParams;
 	FloatParameter * monitorVolume;
@@ -82,6 +85,9 @@ public:
 
 	void updateSelectedMonitorChannels();
 
+	void updateCuePlayer();
+	void playCue(AudioCue* cue, const Array<int>& outChannels, float gain = 1);
+
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 	void onContainerParameterChangedInternal(Parameter * p) override;
 
@@ -111,6 +117,7 @@ public:
 		virtual ~AudioModuleListener() {}
 		virtual void monitorSetupChanged() {}
         virtual void audioSetupChanged() {}
+		virtual void streamSetupChanged() {}
 	};
 
 	ListenerList<AudioModuleListener> audioModuleListeners;
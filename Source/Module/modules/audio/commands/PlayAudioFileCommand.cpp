@@ -19,6 +19,8 @@ PlayAudioFileCommand::PlayAudioFileCommand(AudioModule * _module, CommandContext
 {
 	audioFile = addFileParameter("Audio file", "The Audio file to play");
 	audioFile->fileTypeFilter = "*.wav;*.mp3;*.aiff";
+	preload = addBoolParameter("Preload", "If checked, the file is loaded in memory so it starts without any disk access when triggered. Compressed files are decoded once to a cache file first", false);
+	polyphonic = addBoolParameter("Polyphonic", "If checked, the file is decoded in memory when loaded and shared with all commands playing the same file. Each trigger starts a new voice on top of the ones already playing instead of restarting the sound. Best for short sounds", false);
 
 	addChildControllableContainer(&channelsCC);
 
@@ -39,7 +41,7 @@ PlayAudioFileCommand::PlayAudioFileCommand(AudioModule * _module, CommandContext
 		b->setValue(i < 2, false);
 	}
 
-	formatManager.registerBasicFormats();
+	transportSource.addChangeListener(this);
 	audioModule->addAudioModuleListener(this);
 	updateSelectedOutChannels();
 }
@@ -52,8 +54,16 @@ PlayAudioFileCommand::~PlayAudioFileCommand()
 		audioModule->graph.removeNode(graphID);
 	}
 
+	if (AudioStreamManager* sm = AudioStreamManager::getInstanceWithoutCreating()) sm->cancelPreloads(this);
+
 	currentProcessor->clear();
 	currentProcessor = nullptr;
+
+	transportSource.removeChangeListener(this);
+	transportSource.setSource(nullptr);
+
+	cue = nullptr;
+	if (AudioStreamManager* sm = AudioStreamManager::getInstanceWithoutCreating()) sm->releaseUnusedCues();
 }
 
 void PlayAudioFileCommand::updateSelectedOutChannels()
@@ -93,29 +103,73 @@ void PlayAudioFileCommand::updateSelectedOutChannels()
 
 void PlayAudioFileCommand::setAudioFile(File f)
 {
+	AudioStreamManager::getInstance()->cancelPreloads(this);
+
 	transportSource.setSource(nullptr);
 	readerSource.reset(nullptr);
-	if (!f.exists()) return;
 
-	AudioFormatReader * reader = formatManager.createReaderFor(f);
+	if (cue != nullptr)
+	{
+		cue = nullptr;
+		AudioStreamManager::getInstance()->releaseUnusedCues();
+	}
+
+	if (!f.exists()) return;
 
-	if (reader != nullptr)
+	if (polyphonic->boolValue())
 	{
-		std::unique_ptr<AudioFormatReaderSource> newSource(new AudioFormatReaderSource(reader, true));
-		transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate); 
-		readerSource.reset(newSource.release());
-		fileSampleRate = reader->sampleRate;
-		numFileChannels = reader->numChannels;
+		cue = AudioStreamManager::getInstance()->getCue(f);
+		if (cue != nullptr)
+		{
+			fileSampleRate = (int)cue->sampleRate;
+			numFileChannels = cue->buffer.getNumChannels();
+			updateSelectedOutChannels();
+			return;
+		}
 	}
 
+	//the file is streamed until the preloaded reader is ready
+	setReader(AudioStreamManager::getInstance()->createReaderFor(f));
+	if (readerSource != nullptr && preload->boolValue()) AudioStreamManager::getInstance()->preload(f, this);
+
 	updateSelectedOutChannels();
 }
 
+void PlayAudioFileCommand::setReader(AudioFormatReader* reader)
+{
+	if (reader == nullptr) return;
+
+	bool wasPlaying = transportSource.isPlaying();
+	int64 position = transportSource.getNextReadPosition();
+	transportSource.setSource(nullptr);
+
+	//preloaded files are read from memory, others are decoded ahead on the shared read-ahead thread
+	int readAhead = AudioStreamManager::isPreloaded(reader) || audioModule == nullptr ? 0 : audioModule->readAheadSize->intValue();
+
+	std::unique_ptr<AudioFormatReaderSource> newSource(new AudioFormatReaderSource(reader, true));
+	transportSource.setSource(newSource.get(), readAhead, readAhead > 0 ? &AudioStreamManager::getInstance()->readAheadThread : nullptr, reader->sampleRate);
+	readerSource.reset(newSource.release());
+	fileSampleRate = reader->sampleRate;
+	numFileChannels = reader->numChannels;
+
+	if (position > 0) transportSource.setNextReadPosition(position);
+	if (wasPlaying) transportSource.start();
+}
+
+void PlayAudioFileCommand::preloadFinished(const File& file, AudioFormatReader* reader)
+{
+	std::unique_ptr<AudioFormatReader> preloadedReader(reader);
+	if (preloadedReader == nullptr || file != audioFile->getFile() || readerSource == nullptr) return;
+
+	//same file, the stream is swapped for the mapped one where it is
+	setReader(preloadedReader.release());
+}
+
 void PlayAudioFileCommand::onContainerParameterChanged(Parameter * p)
 {
 	BaseCommand::onContainerParameterChanged(p);
 
-	if (p == audioFile)
+	if (p == audioFile || p == preload || p == polyphonic)
 	{
 		setAudioFile(audioFile->getFile());
 	}
@@ -131,14 +185,33 @@ void PlayAudioFileCommand::onControllableFeedbackUpdate(ControllableContainer *
 	}
 }
 
+void PlayAudioFileCommand::streamSetupChanged()
+{
+	if (readerSource != nullptr) setAudioFile(audioFile->getFile()); //cues don't use the read-ahead buffer
+}
+
 void PlayAudioFileCommand::triggerInternal(int multiplexIndex)
 {
+	if (cue != nullptr)
+	{
+		audioModule->playCue(cue.get(), selectedOutChannels);
+		audioModule->outActivityTrigger->trigger();
+		return;
+	}
+
 	if (readerSource.get() == nullptr) return;
-	transportSource.setPosition(0);
+	//seeking flushes the read-ahead buffer, it is already rewound after each play so the start is buffered
+	if (transportSource.getNextReadPosition() != 0) transportSource.setPosition(0);
 	transportSource.start();
 	audioModule->outActivityTrigger->trigger();
 }
 
+void PlayAudioFileCommand::changeListenerCallback(ChangeBroadcaster* source)
+{
+	//rewind once finished so the read-ahead thread buffers the beginning for the next trigger
+	if (source == &transportSource && !transportSource.isPlaying() && transportSource.hasStreamFinished()) transportSource.setPosition(0);
+}
+
 // PROCESSOR
 
 PlayAudioFileCommandProcessor::PlayAudioFileCommandProcessor(PlayAudioFileCommand * _command) :
@@ -14,7 +14,9 @@ class PlayAudioFileCommandProcessor;
 
 class PlayAudioFileCommand :
 	public BaseCommand,
-	public AudioModule::AudioModuleListener
+	public AudioModule::AudioModuleListener,
+	public AudioStreamManager::PreloadListener,
+	public ChangeListener
 {
 public:
 	PlayAudioFileCommand(AudioModule * _module, CommandContext context, var params, Multiplex* multiplex);
@@ -23,10 +25,12 @@ public:
 	AudioModule * audioModule;
 
 	FileParameter * audioFile;
+	BoolParameter * preload;
+	BoolParameter * polyphonic;
 	PlayAudioFileCommandProcessor * currentProcessor;
 
 	std::unique_ptr<AudioFormatReaderSource> readerSource;
-	AudioFormatManager formatManager;
+	AudioCue::Ptr cue; //in polyphonic mode, the file is played by the module's cue player instead
 	AudioTransportSource transportSource;
 	ChannelRemappingAudioSource channelRemapAudioSource;
 
@@ -40,16 +44,21 @@ public:
 
 	void updateSelectedOutChannels();
 	//void audioSetupChanged() override;
+	void streamSetupChanged() override;
 
 	AudioProcessorGraph::NodeID graphID;
 
 	void setAudioFile(File f);
+	void setReader(AudioFormatReader* reader);
+	void preloadFinished(const File& file, AudioFormatReader* reader) override;
 
 	void onContainerParameterChanged(Parameter * p) override;
 	void onControllableFeedbackUpdate(ControllableContainer * cc, Controllable * c) override;
 
 	void triggerInternal(int multiplexIndex) override;
 
+	void changeListenerCallback(ChangeBroadcaster* source) override;
+
 	static BaseCommand * create(ControllableContainer * module, CommandContext context, var params, Multiplex * multiplex) { return new PlayAudioFileCommand((AudioModule *)module, context, params, multiplex); }
 };
 
@@ -21,12 +21,16 @@ CustomVariablesModule::CustomVariablesModule(CVGroupManager * manager) :
 	
 	defManager->add(CommandDefinition::createDef(this, "", "Set Preset", &CVCommand::create)->addParam("type", CVCommand::SET_PRESET));
 	defManager->add(CommandDefinition::createDef(this, "", "Go to preset", &CVCommand::create)->addParam("type", CVCommand::GO_TO_PRESET));
+	defManager->add(CommandDefinition::createDef(this, "", "Recall Presets", &CVCommand::create, CommandContext::ACTION)->addParam("type", CVCommand::RECALL_PRESETS));
 	defManager->add(CommandDefinition::createDef(this, "", "Kill Go to preset", &CVCommand::create, CommandContext::ACTION)->addParam("type", CVCommand::KILL_GO_TO_PRESET));
 	defManager->add(CommandDefinition::createDef(this, "", "Interpolate presets", &CVCommand::create)->addParam("type", CVCommand::LERP_PRESETS));
 	defManager->add(CommandDefinition::createDef(this, "", "Set Preset Weight", &CVCommand::create)->addParam("type", CVCommand::SET_PRESET_WEIGHT));
 	defManager->add(CommandDefinition::createDef(this, "", "Set Morpher Target", &CVCommand::create)->addParam("type", CVCommand::SET_2DTARGET));
 	defManager->add(CommandDefinition::createDef(this, "", "Load Preset from file", &CVCommand::create)->addParam("type", CVCommand::LOAD_PRESET));
 	defManager->add(CommandDefinition::createDef(this, "", "Save Preset to file", &CVCommand::create)->addParam("type", CVCommand::SAVE_PRESET));
+	defManager->add(CommandDefinition::createDef(this, "", "Set Bank Row", &CVCommand::create)->addParam("type", CVCommand::SET_BANK_ROW));
+	defManager->add(CommandDefinition::createDef(this, "", "Go to Bank Row", &CVCommand::create)->addParam("type", CVCommand::GO_TO_BANK_ROW));
+	defManager->add(CommandDefinition::createDef(this, "", "Interpolate Bank Rows", &CVCommand::create)->addParam("type", CVCommand::LERP_BANK_ROWS));
 }
 
 CustomVariablesModule::~CustomVariablesModule()
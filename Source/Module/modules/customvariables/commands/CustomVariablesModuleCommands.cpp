@@ -17,6 +17,8 @@ CVCommand::CVCommand(CustomVariablesModule* _module, CommandContext context, var
 	targetPreset(nullptr),
 	targetPreset2(nullptr),
 	presetFile(nullptr),
+	row(nullptr),
+	row2(nullptr),
 	time(nullptr),
 	automation(nullptr),
 	value(nullptr)
@@ -27,7 +29,7 @@ CVCommand::CVCommand(CustomVariablesModule* _module, CommandContext context, var
 	type = (Type)(int)params.getProperty("type", 0);
 	manager = _module->manager;
 
-	if (type == SET_2DTARGET || type == KILL_GO_TO_PRESET)
+	if (type == SET_2DTARGET || type == KILL_GO_TO_PRESET || type == SET_BANK_ROW || type == GO_TO_BANK_ROW || type == LERP_BANK_ROWS)
 	{
 		target = addTargetParameter("Target Group", "The group to target for this command", CVGroupManager::getInstance());
 		target->targetType = TargetParameter::CONTAINER;
@@ -39,6 +41,29 @@ CVCommand::CVCommand(CustomVariablesModule* _module, CommandContext context, var
 			value = addPoint2DParameter("Position", "The target position in the 2D interpolator");
 			linkParamToMappingIndex(value, 0);
 		}
+		else if (type == SET_BANK_ROW || type == GO_TO_BANK_ROW || type == LERP_BANK_ROWS)
+		{
+			row = addIntParameter("Row", "The row of the group's preset bank", 1, 1);
+			if (type == LERP_BANK_ROWS)
+			{
+				row2 = addIntParameter("Row 2", "The second row to use for the interpolation", 1, 1);
+				value = addFloatParameter("Value", "The interpolation value to weight between the 2 rows", 0, 0, 1);
+				linkParamToMappingIndex(value, 0);
+			}
+			else
+			{
+				linkParamToMappingIndex(row, 0);
+			}
+
+			if (type == GO_TO_BANK_ROW) addInterpolationParameters();
+		}
+	}
+	else if (type == RECALL_PRESETS)
+	{
+		presetsCC.reset(new ControllableContainer("Presets"));
+		presetsCC->userCanAddControllables = true;
+		presetsCC->customUserCreateControllableFunc = &CVCommand::createPresetTarget;
+		addChildControllableContainer(presetsCC.get());
 	}
 	else if (type == SET_PRESET || type == LERP_PRESETS || type == SET_PRESET_WEIGHT || type == SAVE_PRESET || type == LOAD_PRESET || type == GO_TO_PRESET)
 	{
@@ -51,22 +76,7 @@ CVCommand::CVCommand(CustomVariablesModule* _module, CommandContext context, var
 		{
 
 		case GO_TO_PRESET:
-			time = addFloatParameter("Interpolation time", "Time for the animation to go to the target preset", 1, 0);
-			time->defaultUI = FloatParameter::TIME;
-			time->canBeDisabledByUser = true;
-
-			automation = new Automation("Interpolation Curve");
-			automation->isSelectable = false;
-			automation->length->setValue(1);
-			automation->addKey(0, 0, false);
-			automation->items[0]->easingType->setValueWithData(Easing::BEZIER);
-			automation->addKey(1, 1, false);
-			automation->selectItemWhenCreated = false;
-			automation->editorIsCollapsed = true;
-			automation->editorCanBeCollapsed = true;
-			automation->setCanBeDisabled(true);
-			automation->enabled->setValue(false);
-			addChildControllableContainer(automation, true);
+			addInterpolationParameters();
 			break;
 
 		case LERP_PRESETS:
@@ -105,6 +115,26 @@ CVCommand::~CVCommand()
 
 }
 
+void CVCommand::addInterpolationParameters()
+{
+	time = addFloatParameter("Interpolation time", "Time for the animation to go to the target preset", 1, 0);
+	time->defaultUI = FloatParameter::TIME;
+	time->canBeDisabledByUser = true;
+
+	automation = new Automation("Interpolation Curve");
+	automation->isSelectable = false;
+	automation->length->setValue(1);
+	automation->addKey(0, 0, false);
+	automation->items[0]->easingType->setValueWithData(Easing::BEZIER);
+	automation->addKey(1, 1, false);
+	automation->selectItemWhenCreated = false;
+	automation->editorIsCollapsed = true;
+	automation->editorCanBeCollapsed = true;
+	automation->setCanBeDisabled(true);
+	automation->enabled->setValue(false);
+	addChildControllableContainer(automation, true);
+}
+
 
 void CVCommand::onContainerParameterChanged(Parameter* p)
 {
@@ -195,6 +225,40 @@ void CVCommand::triggerInternal(int multiplexIndex)
 	}
 	break;
 
+	case SET_BANK_ROW:
+	case GO_TO_BANK_ROW:
+	case LERP_BANK_ROWS:
+	{
+		if (!target->targetContainer.wasObjectDeleted() && target->targetContainer != nullptr)
+		{
+			CVGroup* g = static_cast<CVGroup*>(target->targetContainer.get());
+			int r = (int)getLinkedValue(row, multiplexIndex) - 1;
+
+			if (type == SET_BANK_ROW) g->bank.setValuesToRow(r);
+			else if (type == GO_TO_BANK_ROW)
+			{
+				if (g->bank.isValidRow(r)) g->goToBankRow(r, time->enabled ? time->floatValue() : g->bank.getRowTime(r), automation->enabled->boolValue() ? automation : &g->defaultInterpolation);
+			}
+			else g->bank.lerpRows(r, row2->intValue() - 1, getLinkedValue(value, multiplexIndex));
+		}
+	}
+	break;
+
+	case RECALL_PRESETS:
+	{
+		Array<CVPreset*> presets;
+		for (auto& c : presetsCC->controllables)
+		{
+			TargetParameter* tp = dynamic_cast<TargetParameter*>(c);
+			if (tp == nullptr || !tp->enabled || tp->targetContainer.wasObjectDeleted()) continue;
+			if (CVPreset* p = dynamic_cast<CVPreset*>(tp->targetContainer.get())) presets.add(p);
+		}
+
+		//all the values are set in one propagation wave
+		manager->recallPresets(presets);
+	}
+	break;
+
 	case LOAD_PRESET:
 	case SAVE_PRESET:
 	{
@@ -234,6 +298,36 @@ void CVCommand::triggerInternal(int multiplexIndex)
 
 }
 
+void CVCommand::loadJSONDataInternal(var data)
+{
+	BaseCommand::loadJSONDataInternal(data);
+
+	if (presetsCC != nullptr)
+	{
+		for (auto& c : presetsCC->controllables)
+		{
+			if (TargetParameter* tp = dynamic_cast<TargetParameter*>(c)) setupPresetTarget(tp);
+		}
+	}
+}
+
+void CVCommand::createPresetTarget(ControllableContainer* cc)
+{
+	TargetParameter* p = new TargetParameter("Preset", "Preset to recall, presets of all the groups are recalled together", "");
+	setupPresetTarget(p);
+	cc->addParameter(p);
+}
+
+void CVCommand::setupPresetTarget(TargetParameter* p)
+{
+	p->targetType = TargetParameter::CONTAINER;
+	p->customGetTargetContainerFunc = &CVGroupManager::showMenuAndGetPreset;
+	p->defaultParentLabelLevel = 2;
+	p->isRemovableByUser = true;
+	p->canBeDisabledByUser = true;
+	p->saveValueOnly = false;
+}
+
 BaseCommand* CVCommand::create(ControllableContainer* module, CommandContext context, var params, Multiplex* multiplex)
 {
 	return new CVCommand((CustomVariablesModule*)module, context, params, multiplex);
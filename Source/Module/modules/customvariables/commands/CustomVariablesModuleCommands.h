@@ -22,7 +22,7 @@ public:
 
 	CVGroupManager * manager;
 
-	enum Type { SET_PRESET, GO_TO_PRESET, KILL_GO_TO_PRESET, LERP_PRESETS, SET_PRESET_WEIGHT, SET_2DTARGET, LOAD_PRESET, SAVE_PRESET };
+	enum Type { SET_PRESET, GO_TO_PRESET, KILL_GO_TO_PRESET, LERP_PRESETS, SET_PRESET_WEIGHT, SET_2DTARGET, LOAD_PRESET, SAVE_PRESET, SET_BANK_ROW, GO_TO_BANK_ROW, LERP_BANK_ROWS, RECALL_PRESETS };
 	Type type;
 
 	TargetParameter * target;
@@ -30,14 +30,28 @@ public:
 	TargetParameter * targetPreset2;
 	FileParameter* presetFile;
 
+	//scene recall, one target per preset, on any groups
+	std::unique_ptr<ControllableContainer> presetsCC;
+
+	//preset bank rows
+	IntParameter* row;
+	IntParameter* row2;
+
 	//interpolation
 	FloatParameter* time;
 	Automation* automation;
 	
 	Parameter* value;
 
+	void addInterpolationParameters();
+
 	void onContainerParameterChanged(Parameter * p) override;
 	void triggerInternal(int multiplexIndex) override;
 
+	void loadJSONDataInternal(var data) override;
+
+	static void createPresetTarget(ControllableContainer* cc);
+	static void setupPresetTarget(TargetParameter* p);
+
 	static BaseCommand * create(ControllableContainer * module, CommandContext context, var params, Multiplex * multiplex = nullptr);
 };
@@ -54,6 +54,7 @@ DMXModule::DMXModule() :
 
 DMXModule::~DMXModule()
 {
+	if (dmxDevice != nullptr) dmxModuleListeners.call(&DMXModuleListener::dmxDeviceWillChange);
 }
 
 void DMXModule::setCurrentDMXDevice(DMXDevice * d)
@@ -62,6 +63,7 @@ void DMXModule::setCurrentDMXDevice(DMXDevice * d)
 
 	if (dmxDevice != nullptr)
 	{
+		dmxModuleListeners.call(&DMXModuleListener::dmxDeviceWillChange);
 		dmxDevice->removeDMXDeviceListener(this);
 		dmxDevice->clearDevice();
 		moduleParams.removeChildControllableContainer(dmxDevice.get());
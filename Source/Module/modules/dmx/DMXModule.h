@@ -153,6 +153,7 @@ public:
 	public:
 		virtual ~DMXModuleListener() {}
 
+		virtual void dmxDeviceWillChange() {} //the current device is about to be deleted
 		virtual void dmxDeviceChanged() {}
 	};
 
@@ -19,6 +19,8 @@ MIDIModule::MIDIModule(const String & name, bool _useGenericControls) :
 {
 	valuesCC.customControllableComparator = &MIDIModule::midiValueComparator;
 
+	valueLookup.resize(SLOT_MAX * 16 * 128);
+
 	canHandleRouteValues = true;
 	includeValuesInSave = true;
 
@@ -185,6 +187,10 @@ void MIDIModule::onControllableFeedbackUpdateInternal(ControllableContainer * cc
 	{
 		updateMIDIDevices();
 	}
+	else if (c == useHierarchy)
+	{
+		clearValueLookup();
+	}
 
 
 	if (autoFeedback->boolValue())
@@ -244,7 +250,7 @@ void MIDIModule::noteOnReceived(const int & channel, const int & pitch, const in
 	
 	if (logIncomingData->boolValue())  NLOG(niceName, "Note On : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
 
-	if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_ON, pitch);
+	if (useGenericControls) updateValue(channel, velocity, MIDIValueParameter::NOTE_ON, pitch);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOnEventId, Array<var>(channel, pitch, velocity));
 }
@@ -255,7 +261,7 @@ void MIDIModule::noteOffReceived(const int & channel, const int & pitch, const i
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Note Off : " << channel << ", " << MIDIManager::getNoteName(pitch) << ", " << velocity);
 
-	if (useGenericControls) updateValue(channel, MIDIManager::getNoteName(pitch), velocity, MIDIValueParameter::NOTE_OFF, pitch);
+	if (useGenericControls) updateValue(channel, velocity, MIDIValueParameter::NOTE_OFF, pitch);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOffEventId, Array<var>(channel, pitch, velocity));
 	
@@ -267,7 +273,7 @@ void MIDIModule::controlChangeReceived(const int & channel, const int & number,
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Control Change : " << channel << ", " << number << ", " << value);
 
-	if (useGenericControls) updateValue(channel, "CC"+String(number), value, MIDIValueParameter::CONTROL_CHANGE, number);
+	if (useGenericControls) updateValue(channel, value, MIDIValueParameter::CONTROL_CHANGE, number);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(ccEventId, Array<var>(channel, number, value));
 
@@ -307,7 +313,7 @@ void MIDIModule::pitchWheelReceived(const int &channel, const int &value)
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Pitch wheel, channel : " << channel << ", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "PitchWheel", value, MIDIValueParameter::PITCH_WHEEL, 0);
+	if (useGenericControls) updateValue(channel, value, MIDIValueParameter::PITCH_WHEEL, 0);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(pitchWheelEventId, Array<var>(channel, value));
 }
@@ -318,7 +324,7 @@ void MIDIModule::channelPressureReceived(const int& channel, const int& value)
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Channel Pressure, channel : " << channel << ", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "ChannelPressure", value, MIDIValueParameter::CHANNEL_PRESSURE, 0);
+	if (useGenericControls) updateValue(channel, value, MIDIValueParameter::CHANNEL_PRESSURE, 0);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(channelPressureId, Array<var>(channel, value));
 }
@@ -329,7 +335,7 @@ void MIDIModule::afterTouchReceived(const int& channel, const int& note, const i
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "After Touch, channel : " << channel << ", note : " << note <<", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "AfterTouch "+ MIDIManager::getNoteName(note), value, MIDIValueParameter::AFTER_TOUCH, note);
+	if (useGenericControls) updateValue(channel, value, MIDIValueParameter::AFTER_TOUCH, note);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(afterTouchId, Array<var>(channel, note, value));
 }
@@ -471,10 +477,61 @@ var MIDIModule::sendAfterTouchFromScript(const var::NativeFunctionArgs& args)
 	return var();
 }
 
-void MIDIModule::updateValue(const int & channel, const String & n, const int & val, const MIDIValueParameter::Type & type, const int & pitchOrNumber)
+int MIDIModule::getValueLookupIndex(const MIDIValueParameter::Type& type, int channel, int pitchOrNumber)
+{
+	if (channel < 1 || channel > 16 || pitchOrNumber < 0 || pitchOrNumber > 127) return -1;
+
+	int slot = -1;
+	switch (type)
+	{
+	case MIDIValueParameter::NOTE_ON:
+	case MIDIValueParameter::NOTE_OFF: slot = NOTE_SLOT; break;
+	case MIDIValueParameter::CONTROL_CHANGE: slot = CC_SLOT; break;
+	case MIDIValueParameter::PITCH_WHEEL: slot = PITCH_WHEEL_SLOT; break;
+	case MIDIValueParameter::CHANNEL_PRESSURE: slot = CHANNEL_PRESSURE_SLOT; break;
+	case MIDIValueParameter::AFTER_TOUCH: slot = AFTER_TOUCH_SLOT; break;
+	default: return -1;
+	}
+
+	return (slot * 16 + (channel - 1)) * 128 + pitchOrNumber;
+}
+
+void MIDIModule::clearValueLookup()
+{
+	for (auto& v : valueLookup) v = nullptr;
+}
+
+String MIDIModule::getValueName(const MIDIValueParameter::Type& type, const int& pitchOrNumber)
 {
+	switch (type)
+	{
+	case MIDIValueParameter::NOTE_ON:
+	case MIDIValueParameter::NOTE_OFF: return MIDIManager::getNoteName(pitchOrNumber);
+	case MIDIValueParameter::CONTROL_CHANGE: return "CC" + String(pitchOrNumber);
+	case MIDIValueParameter::PITCH_WHEEL: return "PitchWheel";
+	case MIDIValueParameter::CHANNEL_PRESSURE: return "ChannelPressure";
+	case MIDIValueParameter::AFTER_TOUCH: return "AfterTouch " + MIDIManager::getNoteName(pitchOrNumber);
+	default: return "Unknown";
+	}
+}
+
+void MIDIModule::updateValue(const int & channel, const int & val, const MIDIValueParameter::Type & type, const int & pitchOrNumber)
+{
+	int lookupIndex = getValueLookupIndex(type, channel, pitchOrNumber);
+
+	//Fast path, no string work once the value is known
+	if (lookupIndex >= 0 && !manualAddMode)
+	{
+		if (Parameter* p = (Parameter*)valueLookup.getReference(lookupIndex).get())
+		{
+			p->setValue(val);
+			return;
+		}
+	}
+
 	ControllableContainer* cParentContainer = &valuesCC;
 
+	String n = getValueName(type, pitchOrNumber);
 	String pName = n;
 
 	if (useHierarchy->boolValue())
@@ -544,6 +601,8 @@ void MIDIModule::updateValue(const int & channel, const String & n, const int &
 		p->setValue(val);
 	}
 
+	if (p != nullptr && lookupIndex >= 0) valueLookup.set(lookupIndex, p);
+
 }
 
 void MIDIModule::showMenuAndCreateValue(ControllableContainer * container)
@@ -83,6 +83,13 @@ public:
 
 	static MIDIValueComparator midiValueComparator;
 
+	//Lookup table for incoming values, indexed by [slot][channel][pitchOrNumber], filled when values are first found or created.
+	//Weak references so removed values are simply looked up again.
+	enum ValueSlot { NOTE_SLOT, CC_SLOT, PITCH_WHEEL_SLOT, CHANNEL_PRESSURE_SLOT, AFTER_TOUCH_SLOT, SLOT_MAX };
+	Array<WeakReference<Controllable>> valueLookup;
+	static int getValueLookupIndex(const MIDIValueParameter::Type& type, int channel, int pitchOrNumber);
+	void clearValueLookup();
+
 	//Script
 	const Identifier noteOnEventId = "noteOnEvent";
 	const Identifier noteOffEventId = "noteOffEvent";
@@ -139,7 +146,8 @@ public:
 	static var sendChannelPressureFromScript(const var::NativeFunctionArgs& args);
 	static var sendAfterTouchFromScript(const var::NativeFunctionArgs &args);
 
-	void updateValue(const int &channel, const String &n, const int &val, const MIDIValueParameter::Type &type, const int &pitchOrNumber);
+	void updateValue(const int &channel, const int &val, const MIDIValueParameter::Type &type, const int &pitchOrNumber);
+	static String getValueName(const MIDIValueParameter::Type& type, const int& pitchOrNumber);
 
 	static void showMenuAndCreateValue(ControllableContainer * container);
 	static void createThruControllable(ControllableContainer* cc);
@@ -181,6 +189,7 @@ public:
 	void loadJSONDataInternal(var data) override;
 
 	static MIDIModule * create() { return new MIDIModule(); }
+	virtual bool canScheduleOutput() override { return true; }
 	virtual String getDefaultTypeString() const override { return "MIDI"; }
 
 	//InspectableEditor * getEditor(bool isRoot) override;
@@ -709,6 +709,7 @@ OSCOutput::OSCOutput() :
 	remoteHost->setEnabled(!useLocal->boolValue());
 	remotePort = addIntParameter("Remote port", "Port on which the remote host is listening to", 9000, 1024, 65535);
 	listenToOutputFeedback = addBoolParameter("Listen to Feedback", "If checked, this will listen to the (randomly set) bound port of this sender. This is useful when some softwares automatically detect incoming host and port to send back messages.", false);
+	useTimeTags = addBoolParameter("Use Time Tags", "If checked, messages scheduled ahead of time by a sequence are sent right away in a bundle with their time tag, and the receiver is in charge of applying them on time. If not, they are held here and sent at their time.", false);
 
 	if (!Engine::mainEngine->isLoadingFile) setupSender();
 }
@@ -796,10 +797,21 @@ void OSCOutput::setupSender()
 void OSCOutput::sendOSC(const OSCMessage & m)
 {
 	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
+
+	//Without time tags, messages ahead of time are queued when due so their source can still cancel them.
+	//With time tags they are sent right away, the receiver is in charge of them
+	if (!useTimeTags->boolValue())
+	{
+		WeakReference<Inspectable> ref(this);
+		if (EventTimestamp::scheduleAtTimestamp([ref, m]()
+			{
+				if (OSCOutput* o = dynamic_cast<OSCOutput*>(ref.get())) o->sendOSC(m);
+			})) return;
+	}
 	
 	{
 		const ScopedLock sl(queueLock);
-		messageQueue.push(std::make_unique<OSCMessage>(m));
+		messageQueue.push({ std::make_unique<OSCMessage>(m), EventTimestamp::get() });
 	}
 	notify();
 }
@@ -809,20 +821,43 @@ void OSCOutput::run()
 	while (!Engine::mainEngine->isClearing && !threadShouldExit())
 	{
 		std::unique_ptr<OSCMessage> msgToSend;
+		double timestamp = 0;
+		bool sendWithTimeTag = useTimeTags->boolValue();
 
 		{
 			const ScopedLock sl(queueLock);
 			if (!messageQueue.empty())
 			{
-				msgToSend = std::move(messageQueue.front());
-				messageQueue.pop();
+				double delay = messageQueue.front().timestamp - Time::getMillisecondCounterHiRes();
+				if (sendWithTimeTag || delay < 1)
+				{
+					msgToSend = std::move(messageQueue.front().message);
+					timestamp = messageQueue.front().timestamp;
+					messageQueue.pop();
+				}
+				else
+				{
+					timestamp = delay;
+				}
 			}
 		}
-		
+
 		if (msgToSend)
-			sender.send(*msgToSend);
-		else
-			wait(1000); // notify() is called when a message is added to the queue
+		{
+			double delay = timestamp - Time::getMillisecondCounterHiRes();
+			if (sendWithTimeTag && delay >= 1)
+			{
+				OSCBundle bundle(OSCTimeTag(Time(Time::currentTimeMillis() + (int64)delay)));
+				bundle.addElement(*msgToSend);
+				sender.send(bundle);
+			}
+			else
+			{
+				sender.send(*msgToSend);
+			}
+		}
+		else if (timestamp > 0) wait(jmax(1, (int)timestamp)); //hold the queue until the first message is due, messages stay in order
+		else wait(1000); // notify() is called when a message is added to the queue
 	}
 	
 	// Clear queue
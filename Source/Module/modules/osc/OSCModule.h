@@ -29,6 +29,7 @@ public:
 	StringParameter * remoteHost;
 	IntParameter * remotePort;
 	BoolParameter* listenToOutputFeedback;
+	BoolParameter* useTimeTags;
 	std::unique_ptr<OSCReceiver> receiver;
 	std::unique_ptr<DatagramSocket> socket;
 
@@ -46,7 +47,12 @@ public:
 
 private:
 	OSCSender sender;
-	std::queue<std::unique_ptr<OSCMessage>> messageQueue;
+	struct QueuedMessage
+	{
+		std::unique_ptr<OSCMessage> message;
+		double timestamp; //EventTimestamp when the message was sent, 0 for now
+	};
+	std::queue<QueuedMessage> messageQueue;
 	CriticalSection queueLock;
 };
 
@@ -94,6 +100,7 @@ public:
 	//SEND
 	virtual void setupSenders();
 	virtual void sendOSC(const OSCMessage& msg, String ip = "", int port = 0);
+	virtual bool canScheduleOutput() override { return true; }
 
 	//ZEROCONF
 	void setupZeroConf();
@@ -10,7 +10,10 @@
 
 SerialModule::SerialModule(const String& name) :
 	StreamingModule(name),
-	port(nullptr)
+	port(nullptr),
+	queueFifo(queueSize),
+	numDropped(0),
+	latencyCC("Latency Monitor")
 {
 	portParam = new SerialDeviceParameter("Port", "Serial Port to connect", true);
 	moduleParams.addParameter(portParam);
@@ -22,6 +25,26 @@ SerialModule::SerialModule(const String& name) :
 	isConnected->isSavable = false;
 	connectionFeedbackRef = isConnected;
 
+	deliveryMode = moduleParams.addEnumParameter("Delivery Mode", "Realtime parses incoming data directly on the serial thread for the lowest latency.\nMessage Thread queues it and parses it on the main thread, latency will increase when the interface is busy.");
+	deliveryMode->addOption("Realtime", REALTIME)->addOption("Message Thread", MESSAGE_THREAD);
+
+	queuedData.resize(queueSize);
+	queuedTimes.resize(queueSize);
+
+	latencyCC.enabled->setValue(false);
+	resetLatency = latencyCC.addTrigger("Reset", "Reset the latency measurements");
+	maxLatency = latencyCC.addFloatParameter("Max Latency", "The highest latency measured between reading a message from the port and parsing it, in ms", 0, 0);
+	maxLatency->setControllableFeedbackOnly(true);
+	maxLatency->isSavable = false;
+	for (int i = 0; i < SerialLatencyHistogram::numBuckets; ++i)
+	{
+		IntParameter* p = latencyCC.addIntParameter(SerialLatencyHistogram::getBucketName(i), "Number of messages parsed with this latency", 0, 0);
+		p->setControllableFeedbackOnly(true);
+		p->isSavable = false;
+		latencyBuckets.add(p);
+	}
+	moduleParams.addChildControllableContainer(&latencyCC);
+
 	SerialManager::getInstance()->addSerialManagerListener(this);
 
 }
@@ -34,6 +57,8 @@ SerialModule::~SerialModule()
 	}
 
 	setCurrentPort(nullptr);
+	cancelPendingUpdate();
+	stopTimer();
 }
 
 bool SerialModule::setPortStatus(bool status) 
@@ -113,7 +138,17 @@ void SerialModule::onControllableFeedbackUpdateInternal(ControllableContainer* c
 {
 	StreamingModule::onControllableFeedbackUpdateInternal(cc, c);
 
-	if (c == baudRate)
+	if (c == latencyCC.enabled)
+	{
+		if (latencyCC.enabled->boolValue()) startTimer(250);
+		else stopTimer();
+	}
+	else if (c == resetLatency)
+	{
+		latencyHistogram.reset();
+		timerCallback();
+	}
+	else if (c == baudRate)
 	{
 		portParam->openBaudRate = baudRate->intValue();
 		if (port != nullptr && port->isOpen())
@@ -179,6 +214,64 @@ void SerialModule::portRemoved(SerialDevice*)
 
 void SerialModule::serialDataReceived(const var& data)
 {
+	//Called from the serial thread
+	double receiveTime = port != nullptr ? port->thread.lastFrameTime : Time::getMillisecondCounterHiRes();
+
+	if (deliveryMode->getValueDataAsEnum<DeliveryMode>() == REALTIME)
+	{
+		processSerialData(data, receiveTime);
+		return;
+	}
+
+	int start1, size1, start2, size2;
+	queueFifo.prepareToWrite(1, start1, size1, start2, size2);
+	if (size1 + size2 == 0)
+	{
+		numDropped++;
+		return;
+	}
+
+	int index = size1 > 0 ? start1 : start2;
+	queuedData.getReference(index) = data;
+	queuedTimes.set(index, receiveTime);
+	queueFifo.finishedWrite(1);
+
+	triggerAsyncUpdate();
+}
+
+void SerialModule::handleAsyncUpdate()
+{
+	int start1, size1, start2, size2;
+	queueFifo.prepareToRead(queueFifo.getNumReady(), start1, size1, start2, size2);
+
+	for (int i = start1; i < start1 + size1; ++i)
+	{
+		processSerialData(queuedData[i], queuedTimes[i]);
+		queuedData.getReference(i) = var();
+	}
+
+	for (int i = start2; i < start2 + size2; ++i)
+	{
+		processSerialData(queuedData[i], queuedTimes[i]);
+		queuedData.getReference(i) = var();
+	}
+
+	queueFifo.finishedRead(size1 + size2);
+
+	int dropped = numDropped.exchange(0);
+	if (dropped > 0) NLOGWARNING(niceName, dropped << " messages dropped, the message thread is not keeping up. Switch Delivery Mode to Realtime to avoid this.");
+}
+
+void SerialModule::timerCallback()
+{
+	for (int i = 0; i < latencyBuckets.size(); ++i) latencyBuckets[i]->setValue(latencyHistogram.counts[i].load());
+	maxLatency->setValue(latencyHistogram.maxLatency.load());
+}
+
+void SerialModule::processSerialData(const var& data, double receiveTime)
+{
+	if (port == nullptr) return;
+
 	switch (port->mode)
 	{
 
@@ -201,6 +294,8 @@ void SerialModule::serialDataReceived(const var& data)
 		break;
 
 	}
+
+	if (latencyCC.enabled->boolValue()) latencyHistogram.addValue(Time::getMillisecondCounterHiRes() - receiveTime);
 }
 
 var SerialModule::getJSONData()
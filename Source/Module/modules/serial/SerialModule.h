@@ -13,7 +13,9 @@
 class SerialModule : 
 	public StreamingModule,
 	public SerialDevice::SerialDeviceListener,
-	public SerialManager::SerialManagerListener
+	public SerialManager::SerialManagerListener,
+	public AsyncUpdater,
+	public Timer
 {
 public:
 	SerialModule(const String &name = "Serial");
@@ -30,6 +32,23 @@ public:
 	SerialDevice * port; 
 	BoolParameter * isConnected;
 
+	//Delivery
+	enum DeliveryMode { REALTIME, MESSAGE_THREAD };
+	EnumParameter* deliveryMode;
+
+	static const int queueSize = 1024;
+	AbstractFifo queueFifo;
+	Array<var> queuedData;
+	Array<double> queuedTimes;
+	std::atomic<int> numDropped;
+
+	//Latency
+	EnablingControllableContainer latencyCC;
+	Trigger* resetLatency;
+	FloatParameter* maxLatency;
+	Array<IntParameter*> latencyBuckets;
+	SerialLatencyHistogram latencyHistogram;
+
 	virtual void setCurrentPort(SerialDevice *port);
 
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
@@ -46,6 +65,10 @@ public:
 	virtual void portRemoved(SerialDevice *) override;
 	virtual void serialDataReceived(const var &data) override;
 
+	void processSerialData(const var& data, double receiveTime);
+	void handleAsyncUpdate() override;
+	void timerCallback() override;
+
 	virtual var getJSONData() override;
 	virtual void loadJSONDataInternal(var data) override;
 
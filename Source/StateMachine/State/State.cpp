@@ -21,6 +21,10 @@ State::State() :
 	checkTransitionsOnActivate = addBoolParameter("Check transitions on activate", "If checked, this will automatically check for already valid conditions on activate.\n \
 		Otherwise, already valid transition will need to be unvalidated and then validated again to be activated.", false);
 
+	transitionTime = addFloatParameter("Transition Time", "Time in milliseconds the last activation or deactivation of this state took, including its actions and mappings", 0, 0);
+	transitionTime->setControllableFeedbackOnly(true);
+	transitionTime->isSavable = false;
+
 	pm.reset(new ProcessorManager("Processors"));
 	addChildControllableContainer(pm.get());
 
@@ -50,6 +54,8 @@ void State::onContainerParameterChangedInternal(Parameter *p)
 	{		
 		if (!isCurrentlyLoadingData)
 		{
+			double startTime = Time::getMillisecondCounterHiRes();
+
 			if (p == enabled)
 			{
 				stateListeners.call(&StateListener::stateActivationChanged, this);
@@ -93,6 +99,10 @@ void State::onContainerParameterChangedInternal(Parameter *p)
 				}
 
 			}
+
+			double millis = Time::getMillisecondCounterHiRes() - startTime;
+			transitionTime->setValue(millis);
+			stateListeners.call(&StateListener::stateTransitionTimed, this, millis);
 		}
 	}
 	else if (p == loadActivationBehavior)
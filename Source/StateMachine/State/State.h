@@ -27,6 +27,8 @@ public:
 
 	BoolParameter* checkTransitionsOnActivate;
 
+	FloatParameter* transitionTime;
+
 	//Transition
 	Array<StateTransition *> inTransitions;
 	Array<StateTransition *> outTransitions;
@@ -50,6 +52,7 @@ public:
 		virtual ~StateListener() {}
 		virtual void stateActivationChanged(State*) {}
 		virtual void stateStartActivationChanged(State *) {}
+		virtual void stateTransitionTimed(State *, double /*millis*/) {}
 	};
 
 	ListenerList<StateListener> stateListeners;
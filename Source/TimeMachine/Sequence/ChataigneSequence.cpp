@@ -8,10 +8,19 @@
   ==============================================================================
 */
 
+thread_local ChataigneSequence* ChataigneSequence::notifyingSequence = nullptr;
+
 ChataigneSequence::ChataigneSequence() :
 	Sequence(),
 	masterAudioModule(nullptr),
-	masterAudioLayer(nullptr)
+	masterAudioLayer(nullptr),
+	chaseSpeed(1),
+	chaseTickTime(0),
+	isCorrectingChase(false),
+	clockAnchorTime(0),
+	clockAnchorMillis(0),
+	deferringThread(nullptr),
+	lastDrivenMillis(0)
 {
 	midiSyncDevice = new MIDIDeviceParameter("Sync Devices");
 	midiSyncDevice->canBeDisabledByUser = true;
@@ -20,12 +29,26 @@ ChataigneSequence::ChataigneSequence() :
 	mtcSyncOffset = addFloatParameter("Sync Offset", "The time to offset when sending and receiving", 0, 0);
 	mtcSyncOffset->defaultUI = FloatParameter::TIME;
 	reverseOffset = addBoolParameter("Reverse Offset", "This allows negative offset", false);
+	chaseSeekThreshold = addFloatParameter("Chase Seek Threshold", "When receiving MTC, the sequence follows the incoming timecode by adjusting its speed. If the drift is bigger than this, it jumps directly to the received time instead", .1f, .01f, 2);
+	chaseSeekThreshold->defaultUI = FloatParameter::TIME;
+	chaseFreewheel = addFloatParameter("Chase Freewheel", "When receiving MTC, the time the sequence keeps playing at its last speed after the timecode stops, before stopping", .2f, 0, 10);
+	chaseFreewheel->defaultUI = FloatParameter::TIME;
+
+	triggerLookahead = addFloatParameter("Trigger Lookahead", "Time in advance triggers are processed. Their MIDI and OSC outputs are then scheduled at the exact trigger time instead of being sent at the next time update. 0 means no lookahead", 0, 0, .1f);
+	triggerLookahead->defaultUI = FloatParameter::TIME;
+
+	renderTrigger = addTrigger("Render", "Render all mapping layers of this sequence, including their filters, to the Baked File. If no file is set, a .cbak file will be created next to the session file");
+	bakedFile = addFileParameter("Baked File", "The rendered values of this sequence. Use a .csv extension to export as text instead, only .cbak files can be played back");
+	playBaked = addBoolParameter("Play Baked", "If checked, mapping layers that are in the Baked File will send the rendered values instead of processing their mapping", false);
+
+	parallelLayers = addBoolParameter("Parallel Layers", "If checked, mapping layers are processed at the same time on several threads at each time change. Layers sending to the same module are still processed one after the other, in their order", false);
 
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", "Trigger", &ChataigneTriggerLayer::create, this));
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", Mapping1DLayer::getTypeStringStatic(), &Mapping1DLayer::create, this));
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", Mapping2DLayer::getTypeStringStatic(), &Mapping2DLayer::create, this));
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", "Audio", &ChataigneAudioLayer::create, this, true));
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", ColorMappingLayer::getTypeStringStatic(), &ColorMappingLayer::create, this));
+	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", DMXRecordingLayer::getTypeStringStatic(), &DMXRecordingLayer::create, this));
 	layerManager->factory.defs.add(SequenceLayerManager::LayerDefinition::createDef("", "Sequences", &SequenceBlockLayer::create, this)->addParam("manager", ChataigneSequenceManager::getInstance()->getControlAddress()));
 
 	layerManager->addBaseManagerListener(this);
@@ -40,6 +63,16 @@ void ChataigneSequence::clearItem()
 {
 	BaseItem::clearItem();
 
+	bakeRenderer.reset();
+	{
+		GenericScopedLock lock(layerEvaluationLock);
+		layerPool.reset();
+	}
+	{
+		GenericScopedLock lock(bakeLock);
+		bakeReader.reset();
+	}
+
 	setMasterAudioLayer(nullptr);
 	Sequence::clearItem();
 }
@@ -193,6 +226,7 @@ void ChataigneSequence::setupMidiSyncDevices()
 	else
 	{
 		mtcReceiver.reset(new MTCReceiver(midiSyncDevice->inputDevice));
+		mtcReceiver->setFreewheelTime(chaseFreewheel->floatValue());
 		mtcReceiver->addMTCListener(this);
 	}
 	//	}
@@ -200,31 +234,124 @@ void ChataigneSequence::setupMidiSyncDevices()
 
 void ChataigneSequence::onContainerParameterChangedInternal(Parameter* p)
 {
-	Sequence::onContainerParameterChangedInternal(p);
+	if (correctChaseTime(p)) return;
+	if (p == currentTime && !updateDrivingSequence()) return;
 
-	if (mtcSender != nullptr && midiSyncDevice->enabled)
-	{
-		float time = jmax<float>(0, currentTime->floatValue() - (mtcSyncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1)));
+	ChataigneSequence* previousNotifyingSequence = notifyingSequence;
+	if (p == currentTime) notifyingSequence = this;
 
-		if (p == currentTime)
-		{
-			if ((!isPlaying->boolValue() || isSeeking)) mtcSender->setPosition(time, true);
-		}
-		else if (p == playSpeed) mtcSender->setSpeedFactor(playSpeed->floatValue());
-		else if (p == isPlaying)
-		{
-			if (isPlaying->boolValue()) mtcSender->start(time);
-			else mtcSender->pause(false);
-		}
-		else if (p == mtcSyncOffset)
+	if (p == currentTime && parallelLayers->boolValue() && layerManager->items.size() > 1) notifyTimeChangeInParallel(p);
+	else Sequence::onContainerParameterChangedInternal(p);
+
+	notifyingSequence = previousNotifyingSequence;
+
+	updateOutputScheduling(p);
+	updateMTCSender(p);
+
+	if (p == midiSyncDevice)
+	{
+		setupMidiSyncDevices();
+	}
+	else if (p == chaseFreewheel)
+	{
+		if (mtcReceiver != nullptr) mtcReceiver->setFreewheelTime(chaseFreewheel->floatValue());
+	}
+	else if (p == bakedFile)
+	{
+		reloadBakedFile();
+	}
+	else if (p == parallelLayers)
+	{
+		if (!parallelLayers->boolValue())
 		{
-			mtcSender->setPosition(time, true);
+			//waits for an evaluation in progress to finish with the pool
+			GenericScopedLock lock(layerEvaluationLock);
+			layerPool.reset();
 		}
 	}
+}
 
-	if (p == midiSyncDevice)
+bool ChataigneSequence::correctChaseTime(Parameter* p)
+{
+	if (p == isPlaying && !isPlaying->boolValue())
 	{
-		setupMidiSyncDevices();
+		chaseSpeed = 1;
+		return false;
+	}
+
+	if (p != currentTime || chaseSpeed.load() == 1 || !isPlaying->boolValue() || isSeeking || isCorrectingChase || notifyingSequence != nullptr || isDrivenByParent()) return false;
+
+	//tick of this sequence's own clock while chasing MTC, its advance is scaled by the chase rate and the corrected time is notified instead
+	double prevTime = chaseTickTime;
+	double time = currentTime->floatValue();
+	float correctedTime = (float)(prevTime + (time - prevTime) * chaseSpeed.load());
+	if (time <= prevTime || correctedTime == currentTime->floatValue()) return false;
+
+	isCorrectingChase = true;
+	currentTime->setValue(correctedTime);
+	isCorrectingChase = false;
+	return true;
+}
+
+bool ChataigneSequence::updateDrivingSequence()
+{
+	chaseTickTime = currentTime->floatValue();
+
+	if (notifyingSequence != nullptr && notifyingSequence != this)
+	{
+		drivingSequence = notifyingSequence;
+		lastDrivenMillis = Time::getMillisecondCounterHiRes();
+		return true;
+	}
+
+	//tick of this sequence's own clock, the parent sets the time again on its next tick so the layers are only processed then
+	return !isDrivenByParent();
+}
+
+void ChataigneSequence::notifyTimeChangeInParallel(Parameter* p)
+{
+	//Mapping layers are collected while the time change is notified, then processed together
+	//if another thread is evaluating layers right now (e.g. a seek from the UI while playing), this time change is processed in place
+	ScopedTryLock lock(layerEvaluationLock);
+	if (!lock.isLocked())
+	{
+		Sequence::onContainerParameterChangedInternal(p);
+		return;
+	}
+
+	deferringThread = Thread::getCurrentThreadId();
+	Sequence::onContainerParameterChangedInternal(p);
+	deferringThread = nullptr;
+	evaluateDeferredLayers();
+}
+
+void ChataigneSequence::updateOutputScheduling(Parameter* p)
+{
+	//outputs scheduled ahead by the trigger lookahead are not due anymore
+	if ((p == isPlaying && !isPlaying->boolValue()) || (p == currentTime && isSeeking)) cancelScheduledOutputs();
+	if (p == currentTime || p == isPlaying || p == playSpeed) updateClockAnchor();
+}
+
+void ChataigneSequence::updateMTCSender(Parameter* p)
+{
+	if (mtcSender == nullptr || !midiSyncDevice->enabled) return;
+
+	float time = jmax<float>(0, currentTime->floatValue() - getMTCOffset());
+
+	if (p == currentTime)
+	{
+		if ((!isPlaying->boolValue() || isSeeking)) mtcSender->setPosition(time, true);
+		else mtcSender->setReferenceTime(time); //keeps the generator locked to the sequence clock
+	}
+	else if (p == playSpeed) mtcSender->setSpeedFactor(playSpeed->floatValue());
+	else if (p == isPlaying)
+	{
+		if (isPlaying->boolValue()) mtcSender->start(time);
+		else mtcSender->pause(false);
+	}
+	else if (p == mtcSyncOffset)
+	{
+		mtcSender->setPosition(time, true);
 	}
 }
 
@@ -236,7 +363,7 @@ void ChataigneSequence::onControllableStateChanged(Controllable* c)
 		setupMidiSyncDevices();
 		if (mtcSender != nullptr && midiSyncDevice->enabled && isPlaying->boolValue())
 		{
-			float time = jmax<float>(0, currentTime->floatValue() - (mtcSyncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1)));
+			float time = jmax<float>(0, currentTime->floatValue() - getMTCOffset());
 			mtcSender->start(time);
 		}
 	}
@@ -249,6 +376,10 @@ void ChataigneSequence::onContainerTriggerTriggered(Trigger* t)
 	{
 		if (mtcSender != nullptr) mtcSender->stop();
 	}
+	else if (t == renderTrigger)
+	{
+		render();
+	}
 }
 
 void ChataigneSequence::onExternalParameterValueChanged(Parameter* p)
@@ -256,21 +387,266 @@ void ChataigneSequence::onExternalParameterValueChanged(Parameter* p)
 	if (masterAudioModule != nullptr && p == masterAudioModule->enabled) sequenceListeners.call(&SequenceListener::sequenceMasterAudioModuleChanged, this);
 }
 
+void ChataigneSequence::render()
+{
+	if (isPlaying->boolValue())
+	{
+		NLOGWARNING(niceName, "Can't render while the sequence is playing");
+		return;
+	}
+
+	if (bakeRenderer != nullptr && bakeRenderer->isThreadRunning())
+	{
+		NLOGWARNING(niceName, "Already rendering");
+		return;
+	}
+
+	File f = bakedFile->getFile();
+	if (bakedFile->stringValue().isEmpty())
+	{
+		f = Engine::mainEngine->getFile();
+		f = (f.exists() ? f.getParentDirectory() : File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("Chataigne")).getChildFile("baked").getChildFile(File::createLegalFileName(niceName) + ".cbak");
+	}
+
+	bakeRenderer.reset(new SequenceBakeRenderer(this, f));
+	if (bakeRenderer->layers.isEmpty())
+	{
+		NLOGWARNING(niceName, "No mapping layer to render");
+		bakeRenderer.reset();
+		return;
+	}
+
+	bakeRenderer->addRendererListener(this);
+	bakeRenderer->startThread();
+}
+
+void ChataigneSequence::stopRender(MappingLayer* layer)
+{
+	if (bakeRenderer == nullptr || !bakeRenderer->rendersLayer(layer)) return;
+
+	NLOGWARNING(niceName, "Render cancelled, layer " << layer->niceName << " has been removed");
+	bakeRenderer.reset(); //stops the thread, layers check threadShouldExit at each frame
+}
+
+void ChataigneSequence::reloadBakedFile()
+{
+	std::unique_ptr<SequenceBakeReader> reader;
+
+	File f = bakedFile->getFile();
+	if (f.existsAsFile())
+	{
+		reader.reset(new SequenceBakeReader(f));
+		if (!reader->isValid()) reader.reset();
+	}
+
+	{
+		GenericScopedLock lock(bakeLock);
+		bakeReader.swap(reader);
+	}
+
+	for (auto& l : layerManager->items)
+	{
+		if (MappingLayer* ml = dynamic_cast<MappingLayer*>(l)) ml->lastBakedFrame = -1;
+	}
+}
+
+void ChataigneSequence::renderFinished(SequenceBakeRenderer* r)
+{
+	if (!r->success) return;
+
+	//force the reload in case the file was overwritten in place
+	if (bakedFile->getFile() == r->file) reloadBakedFile();
+	else bakedFile->setValue(r->file.getFullPathName());
+}
+
+bool ChataigneSequence::isDrivenByParent()
+{
+	ChataigneSequence* parent = dynamic_cast<ChataigneSequence*>(drivingSequence.get());
+	if (parent == nullptr) return false;
+
+	//the parent stopped or does not set the time anymore (block ended, sequence played on its own)
+	if (!parent->isPlaying->boolValue() || Time::getMillisecondCounterHiRes() - lastDrivenMillis > 100)
+	{
+		drivingSequence = nullptr;
+		return false;
+	}
+
+	return isPlaying->boolValue() && !isSeeking;
+}
+
+bool ChataigneSequence::deferLayerEvaluation(MappingLayer* layer, float prevTime, bool evaluateSkippedData)
+{
+	if (deferringThread.load() != Thread::getCurrentThreadId()) return false;
+	deferredLayers.add({ layer, layerManager->items.indexOf(layer), prevTime, evaluateSkippedData });
+	return true;
+}
+
+void ChataigneSequence::evaluateDeferredLayers()
+{
+	if (deferredLayers.isEmpty()) return;
+
+	//Layers are grouped by the modules they send to, each group is processed in layer order on its own thread
+	Array<Array<DeferredLayer>> groups;
+	Array<Array<Module*>> groupModules;
+
+	for (auto& d : deferredLayers)
+	{
+		Array<Module*> modules;
+		d.layer->getOutputModules(modules);
+
+		int target = -1;
+		for (int g = 0; g < groups.size(); ++g)
+		{
+			bool shared = false;
+			for (auto& m : modules) if (groupModules.getReference(g).contains(m)) shared = true;
+			if (!shared) continue;
+
+			if (target == -1)
+			{
+				target = g;
+				continue;
+			}
+
+			//this layer links two groups, they become one
+			groups.getReference(target).addArray(groups[g]);
+			groupModules.getReference(target).addArray(groupModules[g]);
+			groups.remove(g);
+			groupModules.remove(g);
+			g--;
+		}
+
+		if (target == -1)
+		{
+			target = groups.size();
+			groups.add({});
+			groupModules.add({});
+		}
+
+		groups.getReference(target).add(d);
+		for (auto& m : modules) groupModules.getReference(target).addIfNotAlreadyThere(m);
+	}
+
+	deferredLayers.clearQuick();
+
+	for (auto& g : groups) std::sort(g.begin(), g.end(), [](const DeferredLayer& a, const DeferredLayer& b) { return a.index < b.index; });
+
+	if (groups.size() > 1 && layerPool == nullptr) layerPool.reset(new ThreadPool(jlimit(1, 8, SystemStats::getNumCpus() - 1)));
+
+	std::atomic<int> groupsLeft(groups.size() - 1);
+	WaitableEvent groupsDone;
+
+	for (int g = 1; g < groups.size(); ++g)
+	{
+		Array<DeferredLayer>* group = &groups.getReference(g);
+		layerPool->addJob([this, group, &groupsLeft, &groupsDone]()
+			{
+				for (auto& d : *group) d.layer->evaluateCurrentTime(this, d.prevTime, d.evaluateSkippedData);
+				if (--groupsLeft == 0) groupsDone.signal();
+			});
+	}
+
+	//first group is processed on this thread while the others run
+	for (auto& d : groups.getReference(0)) d.layer->evaluateCurrentTime(this, d.prevTime, d.evaluateSkippedData);
+
+	if (groups.size() > 1) groupsDone.wait();
+
+	//timings are published from this thread, not from the pool
+	for (auto& g : groups)
+	{
+		for (auto& d : g) d.layer->publishEvaluationTime();
+	}
+}
+
+void ChataigneSequence::cancelScheduledOutputs()
+{
+	EventTimestamp::cancelScheduled(this);
+
+	//triggers processed ahead of time have lost their outputs, they must trigger again when reached
+	for (auto& l : layerManager->items)
+	{
+		if (ChataigneTriggerLayer* tl = dynamic_cast<ChataigneTriggerLayer*>(l)) tl->triggerManager->resetTriggersAfter(currentTime->floatValue());
+	}
+}
+
+void ChataigneSequence::updateClockAnchor()
+{
+	double now = Time::getMillisecondCounterHiRes();
+	double time = currentTime->floatValue();
+
+	if (!isPlaying->boolValue() || isSeeking || getEffectiveSpeed() <= 0)
+	{
+		clockAnchorTime = time;
+		clockAnchorMillis = isPlaying->boolValue() ? now : 0;
+		return;
+	}
+
+	//Time updates come in blocks (audio buffers or timer ticks), the anchor is only pulled a bit towards each one so the clock stays steady
+	double predicted = getMillisForTime(time);
+	if (clockAnchorMillis > 0 && fabs(predicted - now) < 5) now = predicted + (now - predicted) * .1;
+
+	clockAnchorTime = time;
+	clockAnchorMillis = now;
+}
+
+float ChataigneSequence::getEffectiveSpeed() const
+{
+	return playSpeed->floatValue() * chaseSpeed.load();
+}
+
+double ChataigneSequence::getMillisForTime(double time) const
+{
+	double anchorMillis = clockAnchorMillis;
+	if (anchorMillis <= 0) return 0;
+
+	double speed = getEffectiveSpeed();
+	if (speed <= 0) return anchorMillis;
+
+	return anchorMillis + (time - clockAnchorTime) / speed * 1000;
+}
+
+double ChataigneSequence::getMTCOffset()
+{
+	return mtcSyncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1);
+}
+
 void ChataigneSequence::mtcStarted()
 {
+	chaseSpeed = 1;
 	playTrigger->trigger();
 }
 
 void ChataigneSequence::mtcStopped()
 {
 	stopTrigger->trigger();
+	chaseSpeed = 1;
 }
 
 void ChataigneSequence::mtcTimeUpdated(bool isFullFrame)
 {
 	if (mtcReceiver == nullptr) return;
 
-	double time = jlimit<float>(0, totalTime->floatValue(), mtcReceiver->getTime() + (mtcSyncOffset->floatValue() * (reverseOffset->boolValue() ? -1 : 1)));
-	double diff = fabs(currentTime->floatValue() - time);
-	setCurrentTime(time, diff > 0.1, isFullFrame && !mtcReceiver->isPlaying);
+	if (isFullFrame || !mtcReceiver->isLocked)
+	{
+		double time = jlimit<float>(0, totalTime->floatValue(), mtcReceiver->getTime() + getMTCOffset());
+		double diff = fabs(currentTime->floatValue() - time);
+		setCurrentTime(time, diff > chaseSeekThreshold->floatValue(), isFullFrame && !mtcReceiver->isPlaying);
+		return;
+	}
+
+	//Chase : the sequence free-runs and its speed is trimmed to follow the estimated master clock,
+	//it only jumps when the drift is too big to be caught up smoothly.
+	//The trim is an internal multiplier of playSpeed, the parameter itself is left to the user
+	double time = jlimit<float>(0, totalTime->floatValue(), mtcReceiver->getEstimatedTime(Time::getMillisecondCounterHiRes()) + getMTCOffset());
+	double drift = time - currentTime->floatValue();
+
+	float userSpeed = playSpeed->floatValue();
+	if (!isPlaying->boolValue() || fabs(drift) > chaseSeekThreshold->floatValue() || userSpeed <= 0)
+	{
+		setCurrentTime(time, true, true);
+		drift = 0;
+	}
+
+	const double catchUpTime = 1; //seconds to absorb the current drift
+	float speed = (float)(mtcReceiver->getRate() * (1 + jlimit(-.05, .05, drift / catchUpTime)));
+	chaseSpeed = userSpeed > 0 ? speed / userSpeed : 1;
 }
@@ -20,7 +20,8 @@ class ChataigneSequence :
 	public Sequence,
 	public SequenceLayerManager::ManagerListener,
 	public ChataigneAudioLayerListener,
-	public MTCReceiver::MTCListener
+	public MTCReceiver::MTCListener,
+	public SequenceBakeRenderer::RendererListener
 {
 public:
 	ChataigneSequence();
@@ -34,6 +35,45 @@ public:
 	std::unique_ptr<MTCReceiver> mtcReceiver;
 	FloatParameter* mtcSyncOffset;
 	BoolParameter* reverseOffset;
+	FloatParameter* chaseSeekThreshold;
+	FloatParameter* chaseFreewheel;
+	std::atomic<float> chaseSpeed; //multiplier of playSpeed while chasing MTC, internal and not saved
+	std::atomic<double> chaseTickTime; //last notified time, own clock ticks are scaled from it while chasing
+	bool isCorrectingChase;
+
+	//Trigger scheduling
+	FloatParameter* triggerLookahead;
+	std::atomic<double> clockAnchorTime; //sequence time at clockAnchorMillis, smoothed over the time updates
+	std::atomic<double> clockAnchorMillis; //Time::getMillisecondCounterHiRes() value, 0 when not playing
+
+	//Baking
+	Trigger* renderTrigger;
+	FileParameter* bakedFile;
+	BoolParameter* playBaked;
+
+	std::unique_ptr<SequenceBakeRenderer> bakeRenderer;
+	std::unique_ptr<SequenceBakeReader> bakeReader;
+	CriticalSection bakeLock;
+
+	//Parallel layer evaluation
+	BoolParameter* parallelLayers;
+	std::unique_ptr<ThreadPool> layerPool;
+	CriticalSection layerEvaluationLock; //held while layers are deferred and evaluated, the pool is only released under it
+	std::atomic<Thread::ThreadID> deferringThread; //thread notifying a time change while layers are deferred, nullptr otherwise
+
+	struct DeferredLayer
+	{
+		MappingLayer* layer;
+		int index; //in the layer manager, to keep the order of layers that share outputs
+		float prevTime;
+		bool evaluateSkippedData;
+	};
+	Array<DeferredLayer> deferredLayers;
+
+	//Nesting, a sequence whose time is set by a parent sequence while the parent notifies its own time follows the parent clock only
+	WeakReference<Inspectable> drivingSequence;
+	double lastDrivenMillis;
+	static thread_local ChataigneSequence* notifyingSequence;
 
 	Factory<SequenceLayer> layerFactory;
 
@@ -54,6 +94,27 @@ public:
 	void addNewMappingLayerFromValues(Array<Point<float>> keys);
 
 	void setupMidiSyncDevices();
+	double getMTCOffset();
+	void updateMTCSender(Parameter* p);
+	bool correctChaseTime(Parameter* p); //true if the time was corrected, the corrected time has been notified instead
+
+	bool isDrivenByParent();
+	bool updateDrivingSequence(); //false if this time change comes from the own clock of a driven sequence and must be ignored
+
+	void notifyTimeChangeInParallel(Parameter* p);
+	bool deferLayerEvaluation(MappingLayer* layer, float prevTime, bool evaluateSkippedData);
+	void evaluateDeferredLayers();
+
+	float getEffectiveSpeed() const;
+	void updateOutputScheduling(Parameter* p);
+	void cancelScheduledOutputs();
+	void updateClockAnchor();
+	double getMillisForTime(double time) const;
+
+	void render();
+	void stopRender(MappingLayer* layer); //joins a render reading this layer, before it is deleted
+	void reloadBakedFile();
+	void renderFinished(SequenceBakeRenderer* r) override;
 
 	virtual void onContainerParameterChangedInternal(Parameter *) override;
 	virtual void onControllableStateChanged(Controllable* c) override;
@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    SequenceBake.cpp
+    Created: 18 Oct 2026 3:12:40pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+SequenceBakeRenderer::SequenceBakeRenderer(ChataigneSequence* sequence, const File& file) :
+	Thread("Sequence Render"),
+	sequence(sequence),
+	file(file),
+	fps(jmax(1.0f, sequence->fps->floatValue())),
+	numFrames((int)(sequence->totalTime->floatValue() * fps) + 1),
+	numColumns(0),
+	success(false)
+{
+	//Layout is gathered on the message thread, rendering only reads the layers afterwards
+	for (auto& l : sequence->layerManager->items)
+	{
+		MappingLayer* ml = dynamic_cast<MappingLayer*>(l);
+		if (ml == nullptr || !ml->enabled->boolValue()) continue;
+
+		int n = ml->getNumRenderedValues();
+		if (n == 0) continue;
+
+		layers.add({ ml, ml->shortName, numColumns, n });
+		numColumns += n;
+	}
+
+	data.calloc((size_t)numFrames * jmax(numColumns, 1));
+}
+
+SequenceBakeRenderer::~SequenceBakeRenderer()
+{
+	cancelPendingUpdate();
+	stopThread(5000);
+}
+
+bool SequenceBakeRenderer::rendersLayer(MappingLayer* layer) const
+{
+	for (auto& l : layers) if (l.layer == layer) return true;
+	return false;
+}
+
+void SequenceBakeRenderer::run()
+{
+	double startTime = Time::getMillisecondCounterHiRes();
+
+	{
+		//Layers are independent so they render in parallel. Time is not split in chunks since filters can keep state from one frame to the next
+		ThreadPool pool(jlimit(1, 16, SystemStats::getNumCpus()));
+		Array<bool> results;
+		results.resize(layers.size());
+
+		OwnedArray<HeapBlock<float>> layerBuffers;
+		for (int i = 0; i < layers.size(); ++i)
+		{
+			LayerInfo info = layers[i];
+			float* dest = layerBuffers.add(new HeapBlock<float>((size_t)numFrames * info.numColumns, true))->get();
+
+			pool.addJob([this, info, dest, &results, i]()
+				{
+					results.getReference(i) = info.layer->renderValues(fps, numFrames, dest, info.numColumns, [this]() { return threadShouldExit(); });
+				});
+		}
+
+		while (pool.getNumJobs() > 0)
+		{
+			if (threadShouldExit())
+			{
+				pool.removeAllJobs(true, 5000);
+				break;
+			}
+			wait(10);
+		}
+
+		if (threadShouldExit()) return;
+
+		//interleave layer buffers into frames
+		for (int i = 0; i < layers.size(); ++i)
+		{
+			const LayerInfo& info = layers.getReference(i);
+			if (!results[i]) LOGWARNING("Layer " << info.name << " could not be rendered");
+
+			const float* src = layerBuffers[i]->get();
+			for (int f = 0; f < numFrames; ++f) memcpy(data.get() + (size_t)f * numColumns + info.firstColumn, src + (size_t)f * info.numColumns, info.numColumns * sizeof(float));
+		}
+	}
+
+	file.getParentDirectory().createDirectory();
+	success = file.hasFileExtension("csv") ? writeCSV() : writeBinary();
+
+	if (success) NLOG(sequence->niceName, "Rendered " << layers.size() << " layers, " << numFrames << " frames to " << file.getFileName() << " in " << (int)(Time::getMillisecondCounterHiRes() - startTime) << "ms");
+	triggerAsyncUpdate();
+}
+
+void SequenceBakeRenderer::handleAsyncUpdate()
+{
+	rendererListeners.call(&RendererListener::renderFinished, this);
+}
+
+bool SequenceBakeRenderer::writeBinary()
+{
+	file.deleteFile();
+	std::unique_ptr<FileOutputStream> stream(file.createOutputStream());
+	if (stream == nullptr || stream->failedToOpen())
+	{
+		LOGERROR("Could not create baked file " << file.getFullPathName());
+		return false;
+	}
+
+	stream->writeInt((int)SEQUENCE_BAKE_MAGIC);
+	stream->writeInt(SEQUENCE_BAKE_VERSION);
+	stream->writeDouble(fps);
+	stream->writeInt(numFrames);
+	stream->writeInt(numColumns);
+
+	stream->writeInt(layers.size());
+	for (auto& l : layers)
+	{
+		stream->writeString(l.name);
+		stream->writeInt(l.firstColumn);
+		stream->writeInt(l.numColumns);
+	}
+
+	//frames are 4-byte aligned so they can be read in place from the mapped file
+	while (stream->getPosition() % 4 != 0) stream->writeByte(0);
+
+	stream->write(data.get(), (size_t)numFrames * numColumns * sizeof(float));
+
+	stream->flush();
+	return !stream->getStatus().failed();
+}
+
+bool SequenceBakeRenderer::writeCSV()
+{
+	file.deleteFile();
+	std::unique_ptr<FileOutputStream> stream(file.createOutputStream());
+	if (stream == nullptr || stream->failedToOpen())
+	{
+		LOGERROR("Could not create baked file " << file.getFullPathName());
+		return false;
+	}
+
+	MemoryOutputStream line;
+	line << "time";
+	for (auto& l : layers)
+	{
+		for (int i = 0; i < l.numColumns; ++i) line << "," << l.name << (l.numColumns > 1 ? ":" + String(i) : "");
+	}
+	line << "\n";
+	stream->write(line.getData(), line.getDataSize());
+
+	for (int f = 0; f < numFrames; ++f)
+	{
+		line.reset();
+		line << String(f / fps, 4);
+		const float* frame = data.get() + (size_t)f * numColumns;
+		for (int i = 0; i < numColumns; ++i) line << "," << String(frame[i]);
+		line << "\n";
+		stream->write(line.getData(), line.getDataSize());
+	}
+
+	stream->flush();
+	return !stream->getStatus().failed();
+}
+
+
+
+juce_ImplementSingleton(LayerBakePool)
+
+LayerBakePool::LayerBakePool() :
+	ThreadPool(jlimit(1, 4, SystemStats::getNumCpus() - 1))
+{
+}
+
+LayerBakePool::~LayerBakePool()
+{
+	removeAllJobs(true, 5000);
+}
+
+void LayerBakePool::removeLayerJobs(MappingLayer* layer, int timeoutMs)
+{
+	struct LayerJobSelector : public ThreadPool::JobSelector
+	{
+		LayerJobSelector(MappingLayer* layer) : layer(layer) {}
+		MappingLayer* layer;
+		bool isJobSuitable(ThreadPoolJob* job) override
+		{
+			MappingLayer::LayerBakeJob* j = dynamic_cast<MappingLayer::LayerBakeJob*>(job);
+			return j != nullptr && j->layer == layer;
+		}
+	};
+
+	LayerJobSelector selector(layer);
+	removeAllJobs(true, timeoutMs, &selector);
+}
+
+
+SequenceBakeReader::SequenceBakeReader(const File& file) :
+	file(file),
+	fps(0),
+	numFrames(0),
+	numColumns(0),
+	frames(nullptr)
+{
+	if (!file.existsAsFile()) return;
+
+	if (file.hasFileExtension("csv"))
+	{
+		LOGWARNING("CSV baked files can't be played back, render to a .cbak file instead");
+		return;
+	}
+
+	mappedFile.reset(new MemoryMappedFile(file, MemoryMappedFile::readOnly));
+	if (mappedFile->getData() == nullptr)
+	{
+		mappedFile.reset();
+		return;
+	}
+
+	MemoryInputStream header(mappedFile->getData(), mappedFile->getSize(), false);
+	if ((uint32)header.readInt() != SEQUENCE_BAKE_MAGIC || header.readInt() > SEQUENCE_BAKE_VERSION)
+	{
+		LOGERROR("File " << file.getFileName() << " is not a valid baked sequence");
+		mappedFile.reset();
+		return;
+	}
+
+	fps = header.readDouble();
+	numFrames = header.readInt();
+	numColumns = header.readInt();
+
+	int numLayers = header.readInt();
+	for (int i = 0; i < numLayers && !header.isExhausted(); ++i)
+	{
+		String name = header.readString();
+		Column c;
+		c.firstColumn = header.readInt();
+		c.numColumns = header.readInt();
+		layerColumns.set(name, c);
+	}
+
+	int64 dataOffset = header.getPosition();
+	while (dataOffset % 4 != 0) dataOffset++;
+
+	if (fps <= 0 || numFrames <= 0 || dataOffset + (int64)numFrames * numColumns * (int64)sizeof(float) > (int64)mappedFile->getSize())
+	{
+		LOGERROR("Baked sequence " << file.getFileName() << " is incomplete");
+		mappedFile.reset();
+		return;
+	}
+
+	frames = (const float*)((const char*)mappedFile->getData() + dataOffset);
+}
+
+SequenceBakeReader::~SequenceBakeReader()
+{
+}
+
+bool SequenceBakeReader::getColumnsForLayer(const String& name, Column& result) const
+{
+	if (!layerColumns.contains(name)) return false;
+	result = layerColumns[name];
+	return result.firstColumn >= 0 && result.firstColumn + result.numColumns <= numColumns;
+}
+
+int SequenceBakeReader::getFrameIndexForTime(double time) const
+{
+	return jlimit(0, numFrames - 1, (int)(time * fps + .5));
+}
+
+const float* SequenceBakeReader::getFrame(int index) const
+{
+	if (!isValid() || index < 0 || index >= numFrames) return nullptr;
+	return frames + (size_t)index * numColumns;
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    SequenceBake.h
+    Created: 18 Oct 2026 3:12:40pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ChataigneSequence;
+class MappingLayer;
+
+/*
+	Baked sequence file layout (little endian) :
+
+	Header    : magic "CBAK", version, fps (double), numFrames, numColumns
+	Layers    : numLayers, then for each layer : name (string), firstColumn, numColumns
+	Data      : numFrames x numColumns floats, frame after frame
+
+	Files with a .csv extension are written as text instead, one row per frame and one column per output value.
+	Only the binary format can be played back.
+*/
+
+#define SEQUENCE_BAKE_MAGIC ByteOrder::littleEndianInt("CBAK")
+#define SEQUENCE_BAKE_VERSION 1
+
+class SequenceBakeRenderer :
+	public Thread,
+	public AsyncUpdater
+{
+public:
+	SequenceBakeRenderer(ChataigneSequence* sequence, const File& file);
+	~SequenceBakeRenderer();
+
+	struct LayerInfo
+	{
+		MappingLayer* layer;
+		String name;
+		int firstColumn;
+		int numColumns;
+	};
+
+	ChataigneSequence* sequence;
+	File file;
+	double fps;
+	int numFrames;
+	int numColumns;
+
+	Array<LayerInfo> layers;
+	HeapBlock<float> data; //numFrames x numColumns
+	bool success;
+
+	bool rendersLayer(MappingLayer* layer) const;
+
+	void run() override;
+	void handleAsyncUpdate() override;
+
+	bool writeBinary();
+	bool writeCSV();
+
+	class RendererListener
+	{
+	public:
+		virtual ~RendererListener() {}
+		virtual void renderFinished(SequenceBakeRenderer*) {}
+	};
+
+	ListenerList<RendererListener> rendererListeners;
+	void addRendererListener(RendererListener* newListener) { rendererListeners.add(newListener); }
+	void removeRendererListener(RendererListener* listener) { rendererListeners.remove(listener); }
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SequenceBakeRenderer)
+};
+
+
+/*
+	Pool shared by the layer bakes of all sequences, so editing many baked layers doesn't start one thread per layer.
+*/
+class LayerBakePool :
+	public ThreadPool
+{
+public:
+	juce_DeclareSingleton(LayerBakePool, true)
+	LayerBakePool();
+	~LayerBakePool();
+
+	void removeLayerJobs(MappingLayer* layer, int timeoutMs); //interrupts and waits for the bake jobs of the layer
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayerBakePool)
+};
+
+
+class SequenceBakeReader
+{
+public:
+	SequenceBakeReader(const File& file);
+	~SequenceBakeReader();
+
+	File file;
+	std::unique_ptr<MemoryMappedFile> mappedFile;
+
+	double fps;
+	int numFrames;
+	int numColumns;
+	const float* frames;
+
+	struct Column
+	{
+		int firstColumn;
+		int numColumns;
+	};
+	HashMap<String, Column> layerColumns;
+
+	bool isValid() const { return frames != nullptr; }
+	bool getColumnsForLayer(const String& name, Column& result) const;
+
+	int getFrameIndexForTime(double time) const;
+	const float* getFrame(int index) const;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SequenceBakeReader)
+};
@@ -21,6 +21,16 @@ ChataigneAudioLayer::ChataigneAudioLayer(ChataigneSequence* _sequence, var param
 	arm = addBoolParameter("Arm", "If checked, this will record audio and save it", false);
 	autoDisarm = addBoolParameter("Auto Disarm", "If checked, this will automatically set Arm to false when the sequence stops", false);
 
+	envelopeRMS = addFloatParameter("Envelope RMS", "RMS level of the audio at the current time, from the clip analysis", 0, 0, 1);
+	envelopePeak = addFloatParameter("Envelope Peak", "Peak level of the audio at the current time, from the clip analysis", 0, 0, 1);
+	envelopeOnset = addFloatParameter("Envelope Onset", "Onset strength of the audio at the current time, high when a new sound starts", 0, 0, 1);
+	for (auto& p : { envelopeRMS, envelopePeak, envelopeOnset })
+	{
+		p->setControllableFeedbackOnly(true);
+		p->isSavable = false;
+	}
+
+	AudioEnvelopeManager::getInstance()->addEnvelopeListener(this);
 	
 	uiHeight->setValue(80);
 }
@@ -34,6 +44,12 @@ void ChataigneAudioLayer::clearItem()
 {
 	AudioLayer::clearItem();
 	if (ModuleManager::getInstanceWithoutCreating() != nullptr) ModuleManager::getInstance()->removeBaseManagerListener(this);
+	if (AudioEnvelopeManager::getInstanceWithoutCreating() != nullptr)
+	{
+		AudioEnvelopeManager::getInstance()->removeEnvelopeListener(this);
+		clipEnvelopes.clear();
+		AudioEnvelopeManager::getInstance()->purgeUnusedEnvelopes();
+	}
 	setAudioModule(nullptr);
 }
 
@@ -91,51 +107,39 @@ void ChataigneAudioLayer::exportRMS(bool toNewMappingLayer, bool toClipboard, bo
 	double frameLength = 1.0 / sequence->fps->intValue();
 	int numFrames = sequence->totalTime->floatValue() / frameLength;
 
-	Array<Point<float>> values;
+	updateClipEnvelopes();
 
-	AudioSampleBuffer buffer;
-	AudioLayerClip* curClip = nullptr;
+	Array<Point<float>> values;
 
 	for (int i = 0; i < numFrames; ++i)
 	{
 		float t = i * frameLength;
-		float value = 0;
-		AudioLayerClip* clip = (AudioLayerClip *)clipManager.getBlockAtTime(t);
-		
-		if (clip != curClip)
-		{
-			curClip = clip;
-			if (curClip != nullptr)
-			{
-				buffer.setSize(2, (int)curClip->readerSource->getAudioFormatReader()->lengthInSamples, false, true);
-				curClip->readerSource->getAudioFormatReader()->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
-			}
-		}
+		bool isReady = true;
+		float value = getEnvelopeValue(AudioEnvelope::RMS, t, frameLength * 10, &isReady);
 
-		
-		if (curClip != nullptr)
+		if (!isReady)
 		{
-			int rmsSampleCount = frameLength * buffer.getNumSamples() / curClip->coreLength->floatValue() * 10;
-			int startSample = (t - clip->time->floatValue()) * buffer.getNumSamples() / curClip->coreLength->floatValue();
-			
-			value = buffer.getRMSLevel(0, startSample, jmin(rmsSampleCount,buffer.getNumSamples()-startSample));
+			//values are exported when the analysis of all the clips is done
+			pendingRMSExports.add({ toNewMappingLayer, toClipboard, dataOnly });
+			NLOG(niceName, "Analyzing audio, RMS will be exported when done");
+			return;
 		}
 
 		values.add({ t, value });
 	}
-;
-	String s = "";
+
+	MemoryOutputStream s;
 	for (int i = 0; i < values.size(); ++i)
 	{
-		if (i > 0) s += "\n";
-		if (!dataOnly) s += String(i) + "\t" + String(values[i].x, 3) + "\t";
-		s+= String(values[i].y, 3);
+		if (i > 0) s << "\n";
+		if (!dataOnly) s << String(i) << "\t" << String(values[i].x, 3) << "\t";
+		s << String(values[i].y, 3);
 	}
 
 
 	if (toClipboard)
 	{
-		SystemClipboard::copyTextToClipboard(s);
+		SystemClipboard::copyTextToClipboard(s.toString());
 		NLOG(niceName, values.size() <<  " keys copied to clipboard");
 	}
 
@@ -145,9 +149,74 @@ void ChataigneAudioLayer::exportRMS(bool toNewMappingLayer, bool toClipboard, bo
 	}
 }
 
+void ChataigneAudioLayer::updateClipEnvelopes()
+{
+	//message thread only, this is where files are touched. The playback thread only reads envelopes that are already there
+	ReferenceCountedArray<AudioEnvelope> envelopes;
+	for (auto& b : clipManager.items)
+	{
+		AudioEnvelope::Ptr e = AudioEnvelopeManager::getInstance()->requestEnvelope(((AudioLayerClip*)b)->filePath->getFile());
+		if (e != nullptr) envelopes.addIfNotAlreadyThere(e.get());
+	}
+
+	clipEnvelopes.swapWith(envelopes);
+	envelopes.clear();
+	AudioEnvelopeManager::getInstance()->purgeUnusedEnvelopes();
+}
+
+float ChataigneAudioLayer::getEnvelopeValue(AudioEnvelope::Type type, float time, float windowLength, bool* isReady)
+{
+	AudioLayerClip* clip = (AudioLayerClip*)clipManager.getBlockAtTime(time);
+	if (clip == nullptr) return 0;
+
+	AudioEnvelope::Ptr e = AudioEnvelopeManager::getInstance()->findEnvelope(clip->filePath->getFile());
+	if (e == nullptr || e->hasFailed) return 0;
+
+	if (!e->isReady)
+	{
+		if (isReady != nullptr) *isReady = false;
+		return 0;
+	}
+
+	//clip time to file time, the clip core length covers the whole file
+	float coreLength = clip->coreLength->floatValue();
+	if (coreLength <= 0) return 0;
+	double stretch = e->getLength() / coreLength;
+	return e->getValue(type, (time - clip->time->floatValue()) * stretch, windowLength * stretch);
+}
+
+void ChataigneAudioLayer::updateEnvelopeValues()
+{
+	float t = sequence->currentTime->floatValue();
+	float window = 1.0f / jmax(1, sequence->fps->intValue());
+	envelopeRMS->setValue(getEnvelopeValue(AudioEnvelope::RMS, t, window));
+	envelopePeak->setValue(getEnvelopeValue(AudioEnvelope::PEAK, t, window));
+	envelopeOnset->setValue(getEnvelopeValue(AudioEnvelope::ONSET, t, window));
+}
+
+void ChataigneAudioLayer::envelopeReady(AudioEnvelope* e)
+{
+	updateEnvelopeValues();
+
+	if (pendingRMSExports.isEmpty()) return;
+
+	Array<PendingRMSExport> exports;
+	exports.swapWith(pendingRMSExports);
+	for (auto& p : exports) exportRMS(p.toNewMappingLayer, p.toClipboard, p.dataOnly);
+}
+
+void ChataigneAudioLayer::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	AudioLayer::onControllableFeedbackUpdateInternal(cc, c);
+
+	AudioLayerClip* clip = dynamic_cast<AudioLayerClip*>(c->parentContainer.get());
+	if (clip != nullptr && c == clip->filePath) updateClipEnvelopes();
+}
+
 void ChataigneAudioLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData)
 {
 	AudioLayer::sequenceCurrentTimeChanged(s, prevTime, evaluateSkippedData);
+	if (enabled->boolValue()) updateEnvelopeValues();
 }
 
 void ChataigneAudioLayer::sequencePlayStateChanged(Sequence* s)
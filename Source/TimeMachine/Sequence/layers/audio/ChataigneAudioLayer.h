@@ -17,7 +17,8 @@ class ChataigneAudioLayerProcessor;
 class ChataigneAudioLayer :
 	public AudioLayer,
 	public ModuleManager::ManagerListener,
-    public AudioModule::AudioModuleListener
+    public AudioModule::AudioModuleListener,
+	public AudioEnvelopeManager::EnvelopeListener
 {
 public:
 	ChataigneAudioLayer(ChataigneSequence * sequence, var params);
@@ -31,6 +32,20 @@ public:
 	BoolParameter * autoDisarm;
 	float timeAtStartRecord;
 
+	//Envelope of the clip at the current time, read from the analysis cache. Can be used as mapping inputs
+	FloatParameter* envelopeRMS;
+	FloatParameter* envelopePeak;
+	FloatParameter* envelopeOnset;
+	ReferenceCountedArray<AudioEnvelope> clipEnvelopes; //keeps the envelopes of the clips loaded
+
+	struct PendingRMSExport
+	{
+		bool toNewMappingLayer;
+		bool toClipboard;
+		bool dataOnly;
+	};
+	Array<PendingRMSExport> pendingRMSExports;
+
 	virtual void clearItem() override;
 
 	void setAudioModule(AudioModule * newModule);
@@ -42,6 +57,13 @@ public:
 	virtual float getVolumeFactor() override;
 	void exportRMS(bool toNewMappingLayer, bool toClipboard, bool dataOnly = false);
 
+	void updateClipEnvelopes();
+	float getEnvelopeValue(AudioEnvelope::Type type, float time, float windowLength, bool* isReady = nullptr);
+	void updateEnvelopeValues();
+	void envelopeReady(AudioEnvelope* e) override;
+
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+
 
 	void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData) override;
 	void sequencePlayStateChanged(Sequence* s) override;
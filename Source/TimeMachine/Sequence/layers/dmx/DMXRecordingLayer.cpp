@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    DMXRecordingLayer.cpp
+    Created: 18 Oct 2026 10:48:05am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+DMXRecordingLayer::DMXRecordingLayer(Sequence* _sequence, var params) :
+	SequenceLayer(_sequence, getTypeStringStatic()),
+	dmxModule(nullptr),
+	dmxDevice(nullptr)
+{
+	saveAndLoadRecursiveData = true;
+
+	moduleTarget = addTargetParameter("Module", "The DMX module to record from and play back to", ModuleManager::getInstance());
+	moduleTarget->targetType = TargetParameter::CONTAINER;
+	moduleTarget->customGetTargetContainerFunc = &ModuleManager::showAndGetModuleOfType<DMXModule>;
+
+	recordingFile = addFileParameter("Recording", "The DMX recording file to play back. This is set automatically after recording");
+	startTime = addFloatParameter("Start Time", "The time in the sequence at which the recording starts", 0, 0);
+	startTime->defaultUI = FloatParameter::TIME;
+	sendOnSeek = addBoolParameter("Send On Seek", "If checked, the frame at the new position will be sent when jumping time", true);
+
+	arm = addBoolParameter("Arm", "If checked, incoming DMX of the target module will be recorded when the sequence plays", false);
+	autoDisarm = addBoolParameter("Auto Disarm", "If checked, this will automatically set Arm to false when the sequence stops", true);
+
+	memset(frameData, 0, 512 * sizeof(uint8));
+	frameValues.resize(512);
+
+	ModuleManager::getInstance()->addBaseManagerListener(this);
+
+	color->setColor(BG_COLOR.brighter(.1f));
+}
+
+DMXRecordingLayer::~DMXRecordingLayer()
+{
+	clearItem();
+}
+
+void DMXRecordingLayer::clearItem()
+{
+	SequenceLayer::clearItem();
+	stopRecording();
+	if (ModuleManager::getInstanceWithoutCreating() != nullptr) ModuleManager::getInstance()->removeBaseManagerListener(this);
+	setDMXModule(nullptr);
+}
+
+void DMXRecordingLayer::setDMXModule(DMXModule* m)
+{
+	if (dmxModule == m) return;
+
+	if (dmxModule != nullptr)
+	{
+		dmxModule->removeDMXModuleListener(this);
+		setDMXDevice(nullptr);
+	}
+
+	dmxModule = m;
+
+	if (dmxModule != nullptr)
+	{
+		dmxModule->addDMXModuleListener(this);
+		setDMXDevice(dmxModule->dmxDevice.get());
+	}
+}
+
+void DMXRecordingLayer::setDMXDevice(DMXDevice* d)
+{
+	if (dmxDevice == d) return;
+	if (dmxDevice != nullptr) dmxDevice->removeDMXDeviceListener(this);
+	dmxDevice = d;
+	if (dmxDevice != nullptr) dmxDevice->addDMXDeviceListener(this);
+}
+
+void DMXRecordingLayer::startRecording()
+{
+	stopRecording();
+	if (dmxDevice == nullptr || !dmxDevice->canReceive)
+	{
+		NLOGWARNING(niceName, "Can't record, the target module has no DMX input");
+		return;
+	}
+
+	File f = Engine::mainEngine->getFile();
+	f = (f.exists() ? f.getParentDirectory() : File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("Chataigne")).getChildFile("dmx");
+	if (!f.exists()) f.createDirectory();
+
+	std::unique_ptr<DMXRecordingWriter> w(new DMXRecordingWriter(f.getNonexistentChildFile("recorded", ".cdmx", false)));
+	if (!w->isOpened()) return;
+
+	startTime->setValue(sequence->currentTime->floatValue());
+
+	GenericScopedLock lock(dmxDevice->dmxLock);
+	writer.reset(w.release());
+}
+
+void DMXRecordingLayer::stopRecording()
+{
+	if (writer == nullptr) return;
+
+	std::unique_ptr<DMXRecordingWriter> w;
+	if (dmxDevice != nullptr)
+	{
+		GenericScopedLock lock(dmxDevice->dmxLock);
+		w.reset(writer.release());
+	}
+	else w.reset(writer.release());
+
+	w->finish();
+	NLOG(niceName, "Recorded " << w->numFrames << " frames to " << w->file.getFileName());
+	recordingFile->setValue(w->file.getFullPathName());
+}
+
+void DMXRecordingLayer::reloadRecording()
+{
+	reader.reset();
+
+	File f = recordingFile->getFile();
+	if (!f.existsAsFile()) return;
+
+	reader.reset(new DMXRecordingReader(f));
+	if (!reader->isValid())
+	{
+		NLOGWARNING(niceName, "Could not load DMX recording " << f.getFileName());
+		reader.reset();
+	}
+}
+
+void DMXRecordingLayer::sendFrameAtTime(double time, bool force)
+{
+	if (reader == nullptr || dmxModule == nullptr || isRecording()) return;
+
+	double t = time - startTime->floatValue();
+	if (t < 0 || t > reader->getLength() + 1) return;
+
+	if (!reader->getFrameAtTime(t, frameData, force)) return;
+
+	for (int i = 0; i < reader->numChannels; ++i) frameValues.set(i, frameData[i]);
+	dmxModule->sendDMXValues(1, frameValues);
+}
+
+void DMXRecordingLayer::onContainerParameterChangedInternal(Parameter* p)
+{
+	SequenceLayer::onContainerParameterChangedInternal(p);
+
+	if (p == moduleTarget) setDMXModule(dynamic_cast<DMXModule*>(moduleTarget->targetContainer.get()));
+	else if (p == recordingFile) reloadRecording();
+}
+
+void DMXRecordingLayer::itemRemoved(Module* m)
+{
+	if (m == dmxModule) setDMXModule(nullptr);
+}
+
+void DMXRecordingLayer::dmxDeviceWillChange()
+{
+	//the old device is still alive here, it is deleted before dmxDeviceChanged
+	stopRecording();
+	setDMXDevice(nullptr);
+}
+
+void DMXRecordingLayer::dmxDeviceChanged()
+{
+	setDMXDevice(dmxModule != nullptr ? dmxModule->dmxDevice.get() : nullptr);
+}
+
+void DMXRecordingLayer::dmxDataInChanged(int, uint8*, const String&)
+{
+	//called from the device receive thread, dmxLock guards the writer swap
+	if (writer == nullptr || dmxDevice == nullptr) return;
+	GenericScopedLock lock(dmxDevice->dmxLock);
+	//stamped with the sequence time so playback stays aligned when the sequence runs at another speed or is paused while recording
+	if (writer != nullptr) writer->addFrame(sequence->currentTime->floatValue() - startTime->floatValue(), dmxDevice->dmxDataIn, 512);
+}
+
+void DMXRecordingLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData)
+{
+	if (!enabled->boolValue() || !sequence->enabled->boolValue()) return;
+	if (!sequence->isPlaying->boolValue() && !(sequence->isSeeking && sendOnSeek->boolValue())) return;
+
+	sendFrameAtTime(sequence->currentTime->floatValue(), sequence->isSeeking);
+}
+
+void DMXRecordingLayer::sequencePlayStateChanged(Sequence* s)
+{
+	if (sequence->isPlaying->boolValue())
+	{
+		if (arm->boolValue()) startRecording();
+	}
+	else
+	{
+		stopRecording();
+		if (autoDisarm->boolValue()) arm->setValue(false);
+	}
+}
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    DMXRecordingLayer.h
+    Created: 18 Oct 2026 10:48:05am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Module/ModuleIncludes.h"
+
+class DMXRecordingLayer :
+	public SequenceLayer,
+	public ModuleManager::ManagerListener,
+	public DMXModule::DMXModuleListener,
+	public DMXDevice::DMXDeviceListener
+{
+public:
+	DMXRecordingLayer(Sequence* sequence, var params);
+	~DMXRecordingLayer();
+
+	TargetParameter* moduleTarget;
+	FileParameter* recordingFile;
+	FloatParameter* startTime;
+	BoolParameter* sendOnSeek;
+
+	//Recording
+	BoolParameter* arm;
+	BoolParameter* autoDisarm;
+
+	DMXModule* dmxModule;
+	DMXDevice* dmxDevice;
+
+	std::unique_ptr<DMXRecordingWriter> writer;
+	std::unique_ptr<DMXRecordingReader> reader;
+
+	uint8 frameData[512];
+	Array<int> frameValues;
+
+	virtual void clearItem() override;
+
+	void setDMXModule(DMXModule* m);
+	void setDMXDevice(DMXDevice* d);
+
+	void startRecording();
+	void stopRecording();
+	bool isRecording() const { return writer != nullptr; }
+
+	void reloadRecording();
+	void sendFrameAtTime(double time, bool force = false);
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+
+	void itemRemoved(Module* m) override;
+	void dmxDeviceWillChange() override;
+	void dmxDeviceChanged() override;
+	void dmxDataInChanged(int numChannels, uint8* values, const String& sourceName = "") override;
+
+	void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData) override;
+	void sequencePlayStateChanged(Sequence* s) override;
+
+	static DMXRecordingLayer* create(Sequence* sequence, var params) { return new DMXRecordingLayer(sequence, params); }
+	virtual String getTypeString() const override { return getTypeStringStatic(); }
+	static String getTypeStringStatic() { return "DMX Recording"; }
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DMXRecordingLayer)
+};
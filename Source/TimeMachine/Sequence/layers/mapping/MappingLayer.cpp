@@ -15,7 +15,19 @@ MappingLayer::MappingLayer(const String &name, Sequence *_sequence, var params)
 	alwaysUpdate(nullptr),
 	sendOnSeek(nullptr),
     mappingInputSource(nullptr),
-    mappingInput(nullptr)
+    mappingInput(nullptr),
+    lastBakedFrame(-1),
+    layerBakedNumFrames(0),
+    layerBakedNumValues(0),
+    layerBakedRate(0),
+    layerBakedLength(0),
+    layerBakeIsDirty(true),
+    layerBakeIsQueued(false),
+    lastLayerBakeRequestTime(0),
+    isBaking(false),
+    lastLayerBakedPosition(-1),
+    evaluationTimeAverage(0),
+    lastEvaluationTimeUpdate(0)
 {
 	canInspectChildContainers = true;
 	saveAndLoadRecursiveData = true;
@@ -30,14 +42,21 @@ MappingLayer::MappingLayer(const String &name, Sequence *_sequence, var params)
 	sendOnStop = addBoolParameter("Send On Stop", " If checked, this will force the value to go through the mapping when sequence stops playing", true);
 	sendOnSeek = addBoolParameter("Send On Seek", " If checked, this will force the value to go through the mapping when jumping time", false);
 
+	bakedPlayback = addBoolParameter("Baked Playback", "If checked, the output of this layer is computed once for the whole sequence, including the mapping filters, and read back when playing instead of being processed at each time change. The bake is refreshed automatically when the layer is edited", false);
+	bakeRate = addIntParameter("Bake Rate", "The number of values per second computed when baking this layer. Values in between are interpolated", 100, 1, 1000);
+
+	evaluationTime = addFloatParameter("Evaluation Time", "Average time in milliseconds this layer takes to process a time change of the sequence, including its mapping and outputs", 0, 0);
+	evaluationTime->setControllableFeedbackOnly(true);
+	evaluationTime->isSavable = false;
+
 	addChildControllableContainer(mapping.get());
 	
 	color->setColor(BG_COLOR.brighter(.1f));
-	
 }
 
 MappingLayer::~MappingLayer()
 {
+	stopRendering();
 }
 
 void MappingLayer::setupMappingInputParameter(Parameter* source)
@@ -57,6 +76,8 @@ void MappingLayer::setupMappingInputParameter(Parameter* source)
 void MappingLayer::updateMappingInputValue(bool forceOutput)
 {
 	if (!enabled->boolValue() || !sequence->enabled->boolValue()) return;
+	if (sendBakedValues(forceOutput)) return;
+
 	updateMappingInputValueInternal();
 	if (forceOutput || alwaysUpdate->boolValue()) mapping->process(true);
 }
@@ -88,24 +109,232 @@ void MappingLayer::exportBakedValues(bool dataOnly)
 		values.add(pValues);
 	}
 
-	String s;
+	MemoryOutputStream s;
 	for (int iv = 0; iv < values.size(); iv++)
 	{
-		if(s.isNotEmpty()) s += "\n";
+		if(iv > 0) s << "\n";
 
-		if(!dataOnly) s += String(iv) + "\t" + String(iv * step) + "\t";
+		if(!dataOnly) s << String(iv) << "\t" << String(iv * step) << "\t";
 
-		Array<float> va = values[iv];
+		const Array<float>& va = values.getReference(iv);
 		for (int i = 0; i < va.size(); ++i)
 		{
-			s += (i > 0 ? "," : "") + String(va[i]);
+			if (i > 0) s << ",";
+			s << String(va[i]);
 		}
 	}
 
-	SystemClipboard::copyTextToClipboard(s);
+	SystemClipboard::copyTextToClipboard(s.toString());
 	NLOG(niceName, values.size() << " keys copied to clipboard");
 }
 
+int MappingLayer::getNumRenderedValues()
+{
+	int result = 0;
+	for (auto& c : mapping->outValuesCC.controllables)
+	{
+		if (Parameter* p = dynamic_cast<Parameter*>(c)) result += p->value.isArray() ? p->value.size() : 1;
+	}
+	return result;
+}
+
+bool MappingLayer::renderValues(double fps, int numFrames, float* dest, int numValues, std::function<bool()> shouldStop)
+{
+	if (mappingInput == nullptr || fps <= 0) return false;
+
+	//the render input and filter chain are detached copies with their own state, so the live mapping is neither processed nor locked while rendering
+	std::unique_ptr<Parameter> input(ControllableFactory::createParameterFrom(mappingInput, false, false));
+	if (input == nullptr) return false;
+
+	var filterData;
+	{
+		ScopedLock filterLock(mapping->fm.filterLock);
+		filterData = mapping->fm.getJSONData();
+	}
+
+	std::unique_ptr<MappingFilterManager> filters(new MappingFilterManager());
+	filters->loadJSONData(filterData);
+
+	Array<Parameter*> inputs;
+	inputs.add(input.get());
+	if (!filters->setupSources(inputs, 0)) return false;
+
+	//time based filters advance by one frame at each process, as they would when playing at this rate
+	for (auto& f : filters->items) f->setFixedDeltaTime(1.0 / fps);
+
+	for (int f = 0; f < numFrames; ++f)
+	{
+		if (shouldStop != nullptr && shouldStop()) break;
+
+		float* frame = dest + (size_t)f * numValues;
+
+		input->setValue(getValueAtPosition((float)(f / fps)));
+		MappingFilter::ProcessResult r = filters->processFilters(inputs, 0);
+
+		if (r == MappingFilter::STOP_HERE)
+		{
+			if (f > 0) memcpy(frame, frame - numValues, numValues * sizeof(float));
+			continue;
+		}
+
+		int index = 0;
+		for (auto& p : filters->getLastFilteredParameters(0))
+		{
+			if (p == nullptr) continue;
+			if (p->value.isArray())
+			{
+				for (int i = 0; i < p->value.size() && index < numValues; ++i) frame[index++] = (float)p->value[i];
+			}
+			else if (index < numValues) frame[index++] = p->type == Parameter::ENUM ? 0 : (float)p->value;
+		}
+	}
+
+	return shouldStop == nullptr || !shouldStop();
+}
+
+void MappingLayer::sendRenderedValues(const float* values, int numValues)
+{
+	GenericScopedLock lock(mapping->mappingLock);
+
+	int index = 0;
+	for (auto& c : mapping->outValuesCC.controllables)
+	{
+		Parameter* p = dynamic_cast<Parameter*>(c);
+		if (p == nullptr) continue;
+
+		if (p->value.isArray())
+		{
+			var v;
+			for (int i = 0; i < p->value.size() && index < numValues; ++i) v.append(values[index++]);
+			p->setValue(v);
+		}
+		else if (index < numValues)
+		{
+			if (p->type != Parameter::ENUM) p->setValue(values[index]);
+			index++;
+		}
+	}
+
+	mapping->om.updateOutputValues(0, mapping->sendOnOutputChangeOnly->boolValue());
+}
+
+bool MappingLayer::sendBakedValues(bool force)
+{
+	if (!canPlayBaked()) return false;
+
+	ChataigneSequence* cs = dynamic_cast<ChataigneSequence*>(sequence);
+	if (cs == nullptr || !cs->playBaked->boolValue()) return sendLayerBakedValues(force);
+
+	ScopedTryLock lock(cs->bakeLock);
+	if (!lock.isLocked() || cs->bakeReader == nullptr) return sendLayerBakedValues(force);
+
+	SequenceBakeReader::Column column;
+	if (!cs->bakeReader->getColumnsForLayer(shortName, column)) return sendLayerBakedValues(force);
+
+	int frameIndex = cs->bakeReader->getFrameIndexForTime(sequence->currentTime->floatValue());
+	if (frameIndex == lastBakedFrame && !force) return true;
+	lastBakedFrame = frameIndex;
+
+	sendRenderedValues(cs->bakeReader->getFrame(frameIndex) + column.firstColumn, column.numColumns);
+	return true;
+}
+
+bool MappingLayer::isPlayingBaked()
+{
+	if (!canPlayBaked()) return false;
+	if (bakedPlayback->boolValue()) return true;
+
+	ChataigneSequence* cs = dynamic_cast<ChataigneSequence*>(sequence);
+	return cs != nullptr && cs->playBaked->boolValue() && cs->bakeReader != nullptr;
+}
+
+void MappingLayer::requestLayerBake()
+{
+	layerBakeIsDirty = true;
+	lastLayerBakeRequestTime = Time::getMillisecondCounterHiRes();
+	if (!bakedPlayback->boolValue()) return;
+
+	//coalesced : a queued or running job bakes again as long as the layer is dirty
+	if (layerBakeIsQueued.exchange(true)) return;
+	LayerBakePool::getInstance()->addJob(new LayerBakeJob(this), true);
+}
+
+void MappingLayer::stopLayerBake()
+{
+	if (LayerBakePool* pool = LayerBakePool::getInstanceWithoutCreating()) pool->removeLayerJobs(this, 5000);
+	layerBakeIsQueued = false;
+}
+
+void MappingLayer::stopRendering()
+{
+	stopLayerBake();
+	if (ChataigneSequence* cs = dynamic_cast<ChataigneSequence*>(sequence)) cs->stopRender(this);
+}
+
+bool MappingLayer::bakeLayer(ThreadPoolJob* job)
+{
+	int numValues = getNumRenderedValues();
+	float length = sequence->totalTime->floatValue();
+	int rate = bakeRate->intValue();
+	int numFrames = (int)(length * rate) + 2; //one extra frame so interpolation at the end stays in range
+
+	if (numValues == 0)
+	{
+		GenericScopedLock lock(layerBakeLock);
+		layerBakedNumFrames = 0;
+		layerBakedLength = length;
+		return false;
+	}
+
+	double startTime = Time::getMillisecondCounterHiRes();
+
+	HeapBlock<float> values((size_t)numFrames * numValues);
+
+	isBaking = true;
+	bool success = renderValues(rate, numFrames, values.get(), numValues, [job]() { return job != nullptr && job->shouldExit(); });
+
+	if (success)
+	{
+		//swapped even if the layer was edited meanwhile, the next bake is already requested and this one is closer than the previous
+		GenericScopedLock lock(layerBakeLock);
+		layerBakedValues.swapWith(values);
+		layerBakedFrame.malloc(numValues);
+		layerBakedNumFrames = numFrames;
+		layerBakedNumValues = numValues;
+		layerBakedRate = rate;
+		layerBakedLength = length;
+		lastLayerBakedPosition = -1;
+	}
+
+	isBaking = false;
+
+	if (success) NLOG(niceName, "Baked " << numFrames << " frames in " << (int)(Time::getMillisecondCounterHiRes() - startTime) << "ms");
+	return success;
+}
+
+bool MappingLayer::sendLayerBakedValues(bool force)
+{
+	if (!bakedPlayback->boolValue()) return false;
+
+	GenericScopedLock lock(layerBakeLock);
+	//edits request their bake themselves, only the sequence length is checked here. Nothing is rendered in the playback path
+	if (!layerBakeIsDirty && !isBaking && layerBakedLength != sequence->totalTime->floatValue()) requestLayerBake();
+
+	if (layerBakedNumFrames < 2) return false;
+
+	double position = jlimit<double>(0, layerBakedNumFrames - 1.001, sequence->currentTime->floatValue() * layerBakedRate);
+	if (position == lastLayerBakedPosition && !force) return true;
+	lastLayerBakedPosition = position;
+
+	int index = (int)position;
+	float frac = (float)(position - index);
+	const float* a = layerBakedValues.get() + (size_t)index * layerBakedNumValues;
+	const float* b = a + layerBakedNumValues;
+	for (int i = 0; i < layerBakedNumValues; ++i) layerBakedFrame[i] = a[i] + (b[i] - a[i]) * frac;
+
+	sendRenderedValues(layerBakedFrame.get(), layerBakedNumValues);
+	return true;
+}
 
 void MappingLayer::onContainerParameterChangedInternal(Parameter * p)
 {
@@ -114,6 +343,24 @@ void MappingLayer::onContainerParameterChangedInternal(Parameter * p)
 	{
 		mapping->setProcessMode(alwaysUpdate->boolValue() ? Mapping::MANUAL : Mapping::VALUE_CHANGE);
 	}
+	else if (p == bakeRate)
+	{
+		requestLayerBake();
+	}
+	else if (p == bakedPlayback)
+	{
+		if (bakedPlayback->boolValue()) requestLayerBake();
+		else
+		{
+			//free the baked values and get back to the live state
+			stopLayerBake();
+			GenericScopedLock lock(layerBakeLock);
+			layerBakedValues.free();
+			layerBakedNumFrames = 0;
+			layerBakeIsDirty = true;
+		}
+		updateMappingInputValue(true);
+	}
 }
 
 void MappingLayer::onContainerTriggerTriggered(Trigger * t)
@@ -125,6 +372,14 @@ void MappingLayer::onControllableFeedbackUpdateInternal(ControllableContainer *
 {
 	SequenceLayer::onControllableFeedbackUpdateInternal(cc, c);
 	if (c == mappingInputSource) updateMappingInputValue();
+
+	//Any edit of the content or the mapping invalidates the bake, except for values that change while sending
+	if (cc == this || c == mappingInputSource || c == mappingInput) return;
+	for (ControllableContainer* pc = cc; pc != nullptr && pc != this; pc = pc->parentContainer)
+	{
+		if (pc == &mapping->outValuesCC || pc == &mapping->om) return;
+	}
+	requestLayerBake();
 }
 
 void MappingLayer::onExternalParameterRangeChanged(Parameter* p)
@@ -136,10 +391,52 @@ void MappingLayer::onExternalParameterRangeChanged(Parameter* p)
 	}
 }
 
+void MappingLayer::getOutputModules(Array<Module*>& modules)
+{
+	for (auto& o : mapping->om.items)
+	{
+		if (!o->enabled->boolValue()) continue;
+		modules.addIfNotAlreadyThere(o->command != nullptr ? o->command->module : nullptr);
+	}
+}
+
 void MappingLayer::sequenceCurrentTimeChanged(Sequence * s, float prevTime, bool evaluateSkippedData)
+{
+	if (ChataigneSequence* cs = dynamic_cast<ChataigneSequence*>(sequence))
+	{
+		if (cs->deferLayerEvaluation(this, prevTime, evaluateSkippedData)) return;
+	}
+
+	evaluateCurrentTime(s, prevTime, evaluateSkippedData);
+	publishEvaluationTime();
+}
+
+void MappingLayer::evaluateCurrentTime(Sequence* s, float prevTime, bool evaluateSkippedData)
+{
+	double startTime = Time::getMillisecondCounterHiRes();
+	processCurrentTime(s, prevTime, evaluateSkippedData);
+	double now = Time::getMillisecondCounterHiRes();
+
+	evaluationTimeAverage += ((now - startTime) - evaluationTimeAverage) * .1;
+}
+
+void MappingLayer::publishEvaluationTime()
+{
+	double now = Time::getMillisecondCounterHiRes();
+	if (now - lastEvaluationTimeUpdate > 250)
+	{
+		evaluationTime->setValue(evaluationTimeAverage);
+		lastEvaluationTimeUpdate = now;
+	}
+}
+
+void MappingLayer::processCurrentTime(Sequence * s, float prevTime, bool evaluateSkippedData)
 {
 	if (!enabled->boolValue() || !sequence->enabled->boolValue() || alwaysUpdate == nullptr || sendOnSeek == nullptr) return;
 
+	//baked layers don't evaluate their content at all while playing
+	if (isPlayingBaked() && sendBakedValues(sequence->isSeeking)) return;
+
 	sequenceCurrentTimeChangedInternal(s, prevTime, evaluateSkippedData);
 
 	if (alwaysUpdate->boolValue() || (sequence->isSeeking && sendOnSeek->boolValue()))
@@ -157,3 +454,37 @@ void MappingLayer::sequencePlayStateChanged(Sequence * s)
 	bool updateAndProcess = (sequence->isPlaying->boolValue() && sendOnPlay->boolValue()) || (!sequence->isPlaying->boolValue() && sendOnStop->boolValue());
 	if (updateAndProcess) updateMappingInputValue(true);
 }
+
+
+MappingLayer::LayerBakeJob::LayerBakeJob(MappingLayer* layer) :
+	ThreadPoolJob("Layer Bake"),
+	layer(layer)
+{
+}
+
+MappingLayer::LayerBakeJob::~LayerBakeJob()
+{
+}
+
+ThreadPoolJob::JobStatus MappingLayer::LayerBakeJob::runJob()
+{
+	while (layer->layerBakeIsDirty)
+	{
+		//edits come in bursts (key drags, loading), the bake starts once they settle
+		while (Time::getMillisecondCounterHiRes() - layer->lastLayerBakeRequestTime < 20)
+		{
+			if (shouldExit()) return jobHasFinished;
+			Thread::sleep(5);
+		}
+
+		if (shouldExit()) return jobHasFinished;
+
+		layer->layerBakeIsDirty = false;
+		layer->bakeLayer(this);
+	}
+
+	//a request coming after the last check either queues a new job or makes this one run again
+	layer->layerBakeIsQueued = false;
+	if (layer->layerBakeIsDirty && !layer->layerBakeIsQueued.exchange(true)) return jobNeedsRunningAgain;
+	return jobHasFinished;
+}
@@ -26,6 +26,14 @@ public:
 	BoolParameter* sendOnStop;
 	BoolParameter* sendOnSeek;
 
+	//Baked playback, the whole layer output is precomputed and read back by index while playing
+	BoolParameter* bakedPlayback;
+	IntParameter* bakeRate;
+
+	FloatParameter* evaluationTime;
+	double evaluationTimeAverage;
+	double lastEvaluationTimeUpdate;
+
 	Parameter* mappingInputSource;
 	Parameter* mappingInput;
 	std::unique_ptr<Mapping> mapping;
@@ -38,12 +46,59 @@ public:
 	virtual var getValueAtPosition(float position) = 0;
 	void exportBakedValues(bool dataOnly = false);
 
+	//Offline rendering : evaluates the layer and a copy of its mapping filters at each frame without sending anything, and plays rendered values back directly to the outputs
+	int getNumRenderedValues();
+	bool renderValues(double fps, int numFrames, float* dest, int numValues, std::function<bool()> shouldStop = nullptr);
+	void sendRenderedValues(const float* values, int numValues);
+
+	int lastBakedFrame;
+	bool sendBakedValues(bool force = false);
+
+	CriticalSection layerBakeLock;
+	HeapBlock<float> layerBakedValues; //layerBakedNumFrames x layerBakedNumValues
+	HeapBlock<float> layerBakedFrame;
+	int layerBakedNumFrames;
+	int layerBakedNumValues;
+	int layerBakedRate;
+	float layerBakedLength;
+	std::atomic<bool> layerBakeIsDirty;
+	std::atomic<bool> layerBakeIsQueued; //a job is queued or running, later requests only set the dirty flag
+	std::atomic<double> lastLayerBakeRequestTime;
+	std::atomic<bool> isBaking;
+	double lastLayerBakedPosition;
+
+	//Bakes are computed by a job on the LayerBakePool, the previous bake (or the live mapping if there is none yet) keeps playing until the new one is swapped in
+	class LayerBakeJob :
+		public ThreadPoolJob
+	{
+	public:
+		LayerBakeJob(MappingLayer* layer);
+		~LayerBakeJob();
+
+		MappingLayer* layer;
+		JobStatus runJob() override;
+	};
+
+	virtual bool canPlayBaked() { return true; }
+	bool isPlayingBaked();
+	void requestLayerBake();
+	void stopLayerBake();
+	void stopRendering(); //stops the layer bake and a sequence render reading this layer, must be called by the final layer classes before the content read by getValueAtPosition is deleted
+	bool bakeLayer(ThreadPoolJob* job);
+	bool sendLayerBakedValues(bool force = false);
+
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 	virtual void onContainerTriggerTriggered(Trigger* t) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 	void onExternalParameterRangeChanged(Parameter* p) override;
 
+	//Modules the outputs of this layer send to, layers sharing one are never evaluated at the same time
+	void getOutputModules(Array<Module*>& modules);
+
 	void sequenceCurrentTimeChanged(Sequence*, float prevTime, bool evaluateSkippedData) override;
+	void evaluateCurrentTime(Sequence*, float prevTime, bool evaluateSkippedData);
+	void publishEvaluationTime();
+	virtual void processCurrentTime(Sequence*, float prevTime, bool evaluateSkippedData);
 	virtual void sequenceCurrentTimeChangedInternal(Sequence*, float prevTime, bool evaluateSkippedData) {};
 	void sequencePlayStateChanged(Sequence*) override;
 	virtual void sequencePlayStateChangedInternal(Sequence*) {}
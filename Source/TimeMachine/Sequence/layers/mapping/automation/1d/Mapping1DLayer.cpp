@@ -33,6 +33,7 @@ Mapping1DLayer::Mapping1DLayer(Sequence* s, var params) :
 
 Mapping1DLayer::~Mapping1DLayer()
 {
+	stopRendering();
 }
 
 var Mapping1DLayer::getValueAtPosition(float position)
@@ -32,6 +32,7 @@ Mapping2DLayer::Mapping2DLayer(Sequence* s, var params) :
 
 Mapping2DLayer::~Mapping2DLayer()
 {
+	stopRendering();
 }
 
 void Mapping2DLayer::addDefaultContent()
@@ -29,6 +29,8 @@ public:
     virtual void updateMappingInputValueInternal() override;
     virtual void stopRecorderAndAddKeys() {}
 
+    bool canPlayBaked() override { return !recorder.isRecording->boolValue(); }
+
     void selectAll(bool addToSelection = false) override;
 
     Array<Inspectable*> selectAllItemsBetweenInternal(float start, float end) override;
@@ -29,6 +29,7 @@ ColorMappingLayer::ColorMappingLayer(Sequence* s, var params) :
 
 ColorMappingLayer::~ColorMappingLayer()
 {
+	stopRendering();
 }
 
 void ColorMappingLayer::addDefaultContent()
@@ -88,8 +89,9 @@ bool ColorMappingLayer::paste()
     return SequenceLayer::paste();
 }
 
-void ColorMappingLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool seeking)
+void ColorMappingLayer::processCurrentTime(Sequence* s, float prevTime, bool seeking)
 {
+    if (enabled->boolValue() && sequence->enabled->boolValue() && isPlayingBaked() && sendBakedValues(sequence->isSeeking)) return;
     colorManager.position->setValue(sequence->currentTime->floatValue());
 }
 
@@ -32,7 +32,7 @@ public:
     virtual bool paste() override;
 
 
-    virtual void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool seeking) override;
+    virtual void processCurrentTime(Sequence* s, float prevTime, bool seeking) override;
     virtual void sequenceTotalTimeChanged(Sequence* s) override;
 
     SequenceLayerPanel* getPanel() override;
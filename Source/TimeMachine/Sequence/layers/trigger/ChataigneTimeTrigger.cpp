@@ -36,6 +36,11 @@ void ChataigneTimeTrigger::triggerInternal()
 	csm->triggerAll();
 }
 
+bool ChataigneTimeTrigger::canScheduleOutputs()
+{
+	return csm->canScheduleOutputs();
+}
+
 var ChataigneTimeTrigger::getJSONData()
 {
 	var data = TimeTrigger::getJSONData();
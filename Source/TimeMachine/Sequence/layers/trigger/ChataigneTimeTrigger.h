@@ -24,6 +24,7 @@ public:
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 
 	virtual void triggerInternal() override;
+	bool canScheduleOutputs();
 
 	virtual var getJSONData() override;
 	virtual void loadJSONDataInternal(var data) override;
@@ -12,7 +12,8 @@ ChataigneTriggerLayer::ChataigneTriggerLayer(Sequence* _sequence, var params) :
 	TriggerLayer(_sequence, getTypeString(), params)
 {
 	helpID = "ChataigneTriggerLayer";
-	setManager(new ChataigneTriggerManager(this, _sequence));
+	triggerManager = new ChataigneTriggerManager(this, _sequence);
+	setManager(triggerManager);
 }
 
 ChataigneTriggerLayer::~ChataigneTriggerLayer()
@@ -22,7 +23,9 @@ ChataigneTriggerLayer::~ChataigneTriggerLayer()
 
 
 ChataigneTriggerManager::ChataigneTriggerManager(ChataigneTriggerLayer* layer, Sequence* sequence) :
-	TimeTriggerManager(layer, sequence)
+	TimeTriggerManager(layer, sequence),
+	triggerLayer(layer),
+	indexIsDirty(true)
 {
 }
 
@@ -34,3 +37,117 @@ TimeTrigger* ChataigneTriggerManager::createItem()
 {
 	return new ChataigneTimeTrigger();
 }
+
+void ChataigneTriggerManager::addItemInternal(TimeTrigger* t, var data)
+{
+	TimeTriggerManager::addItemInternal(t, data);
+	indexIsDirty = true;
+}
+
+void ChataigneTriggerManager::removeItemInternal(TimeTrigger* t)
+{
+	TimeTriggerManager::removeItemInternal(t);
+
+	//the trigger is about to be deleted, make sure the index doesn't point to it anymore
+	GenericScopedLock lock(indexLock);
+	triggerIndex.clearQuick();
+	indexIsDirty = true;
+}
+
+void ChataigneTriggerManager::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	TimeTriggerManager::onControllableFeedbackUpdateInternal(cc, c);
+
+	if (TimeTrigger* t = dynamic_cast<TimeTrigger*>(cc))
+	{
+		if (c == t->time || c == t->enabled) indexIsDirty = true;
+	}
+}
+
+void ChataigneTriggerManager::rebuildIndex()
+{
+	triggerIndex.clearQuick();
+	for (auto& t : items)
+	{
+		if (!t->enabled->boolValue()) continue;
+		triggerIndex.add({ t->time->floatValue(), t });
+	}
+
+	std::stable_sort(triggerIndex.begin(), triggerIndex.end());
+	indexIsDirty = false;
+}
+
+int ChataigneTriggerManager::getFirstIndexedTrigger(float time) const
+{
+	IndexedTrigger ref = { time, nullptr };
+	return (int)(std::lower_bound(triggerIndex.begin(), triggerIndex.end(), ref) - triggerIndex.begin());
+}
+
+void ChataigneTriggerManager::resetTriggersAfter(float time)
+{
+	GenericScopedLock lock(indexLock);
+	if (indexIsDirty) rebuildIndex();
+
+	for (int i = getFirstIndexedTrigger(time); i < triggerIndex.size(); ++i)
+	{
+		const IndexedTrigger& it = triggerIndex.getReference(i);
+		if (it.time > time && it.trigger->isTriggered->boolValue()) it.trigger->isTriggered->setValue(false);
+	}
+}
+
+void ChataigneTriggerManager::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData)
+{
+	if (!triggerLayer->enabled->boolValue() || !s->enabled->boolValue()) return;
+
+	float curTime = s->currentTime->floatValue();
+	bool isPlaying = s->isPlaying->boolValue();
+	bool playingForward = isPlaying && !s->isSeeking && curTime > prevTime;
+
+	GenericScopedLock lock(indexLock);
+	if (indexIsDirty) rebuildIndex();
+
+	int numIndexed = triggerIndex.size();
+	int startIndex = getFirstIndexedTrigger(curTime >= prevTime ? prevTime : curTime);
+
+	if (curTime >= prevTime)
+	{
+		//skipped triggers only fire while playing, a forward seek while stopped leaves them as they are
+		if (!isPlaying || !evaluateSkippedData) return;
+
+		//With a lookahead, triggers slightly ahead are processed now and their outputs are scheduled at their exact time.
+		//Only triggers whose consequences can all be scheduled (MIDI, OSC) are processed ahead, the others wait for their time.
+		//Seeks have no lookahead, the triggers they skip are due now
+		ChataigneSequence* cs = dynamic_cast<ChataigneSequence*>(s);
+		float endTime = curTime;
+		if (cs != nullptr && playingForward) endTime = jmin(s->totalTime->floatValue(), curTime + cs->triggerLookahead->floatValue() * cs->getEffectiveSpeed());
+
+		for (int i = startIndex; i < numIndexed; ++i)
+		{
+			const IndexedTrigger& it = triggerIndex.getReference(i);
+			if (it.time > endTime) break;
+			if (it.trigger->isTriggered->boolValue()) continue;
+
+			if (cs != nullptr && it.time > curTime)
+			{
+				ChataigneTimeTrigger* ct = dynamic_cast<ChataigneTimeTrigger*>(it.trigger);
+				if (ct == nullptr || !ct->canScheduleOutputs()) continue;
+
+				EventTimestamp::Scope scope(cs->getMillisForTime(it.time), cs);
+				it.trigger->trigger();
+			}
+			else
+			{
+				it.trigger->trigger();
+			}
+		}
+	}
+	else
+	{
+		//going back in time, everything after the new time can be triggered again
+		for (int i = startIndex; i < numIndexed; ++i)
+		{
+			const IndexedTrigger& it = triggerIndex.getReference(i);
+			if (it.trigger->isTriggered->boolValue()) it.trigger->isTriggered->setValue(false);
+		}
+	}
+}
@@ -19,7 +19,31 @@ public:
 	ChataigneTriggerManager(ChataigneTriggerLayer* layer, Sequence* sequence);
 	~ChataigneTriggerManager();
 
+	ChataigneTriggerLayer* triggerLayer;
+
+	//Triggers sorted by time, rebuilt only after edits so finding the crossed triggers is a binary search
+	struct IndexedTrigger
+	{
+		float time;
+		TimeTrigger* trigger;
+		bool operator <(const IndexedTrigger& other) const { return time < other.time; }
+	};
+
+	Array<IndexedTrigger> triggerIndex;
+	std::atomic<bool> indexIsDirty;
+	CriticalSection indexLock;
+
 	TimeTrigger* createItem() override;
+
+	void addItemInternal(TimeTrigger* t, var data) override;
+	void removeItemInternal(TimeTrigger* t) override;
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+
+	void rebuildIndex();
+	int getFirstIndexedTrigger(float time) const;
+	void resetTriggersAfter(float time); //triggers processed ahead by the lookahead whose outputs were cancelled
+
+	void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData) override;
 };
 
 
@@ -30,6 +54,8 @@ public :
 	ChataigneTriggerLayer(Sequence * _sequence, var params = var());
 	~ChataigneTriggerLayer();
 
+	ChataigneTriggerManager* triggerManager;
+
 	static ChataigneTriggerLayer* create(Sequence* sequence, var params) { return new ChataigneTriggerLayer(sequence, params); }
 	virtual String getTypeString() const override { return "Trigger"; }
 
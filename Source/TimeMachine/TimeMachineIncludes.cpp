@@ -15,9 +15,11 @@
 
 #include "ChataigneSequenceManager.cpp"
 #include "Sequence/ChataigneSequence.cpp"
+#include "Sequence/bake/SequenceBake.cpp"
 #include "Sequence/layers/audio/ChataigneAudioLayer.cpp"
 #include "Sequence/layers/audio/ui/ChataigneAudioLayerPanel.cpp"
 #include "Sequence/layers/audio/ui/ChataigneAudioLayerTimeline.cpp"
+#include "Sequence/layers/dmx/DMXRecordingLayer.cpp"
 #include "Sequence/layers/mapping/MappingLayer.cpp"
 #include "Sequence/layers/mapping/automation/1d/Mapping1DLayer.cpp"
 #include "Sequence/layers/mapping/automation/1d/ui/Mapping1DLayerPanel.cpp"
@@ -15,6 +15,7 @@
 #include "Sequence/layers/audio/ChataigneAudioLayerListener.h"
 #include "Common/CommonIncludes.h"
 
+#include "Sequence/bake/SequenceBake.h"
 #include "ChataigneSequenceManager.h"
 #include "Sequence/ChataigneSequence.h"
 
@@ -46,3 +47,5 @@
 
 #include "Sequence/layers/mapping/color/ui/ColorMappingLayerTimeline.h"
 
+#include "Sequence/layers/dmx/DMXRecordingLayer.h"
+